@@ -1119,7 +1119,7 @@ void arm7_cpu_device::arm7_cpu_write32(UINT32 addr, UINT32 data)
 	}
 
 	addr &= ~3;
-	m_program->write_dword(addr, data);
+	m_program->write_dword_tlb(addr, data);
 }
 
 
@@ -1134,7 +1134,7 @@ void arm7_cpu_device::arm7_cpu_write16(UINT32 addr, UINT16 data)
 	}
 
 	addr &= ~1;
-	m_program->write_word(addr, data);
+	m_program->write_word_tlb(addr, data);
 }
 
 void arm7_cpu_device::arm7_cpu_write8(UINT32 addr, UINT8 data)
@@ -1147,7 +1147,7 @@ void arm7_cpu_device::arm7_cpu_write8(UINT32 addr, UINT8 data)
 		}
 	}
 
-	m_program->write_byte(addr, data);
+	m_program->write_byte_tlb(addr, data);
 }
 
 UINT32 arm7_cpu_device::arm7_cpu_read32(UINT32 addr)
@@ -1164,12 +1164,12 @@ UINT32 arm7_cpu_device::arm7_cpu_read32(UINT32 addr)
 
 	if (addr & 3)
 	{
-		result = m_program->read_dword(addr & ~3);
+		result = m_program->read_dword_tlb(addr & ~3);
 		result = (result >> (8 * (addr & 3))) | (result << (32 - (8 * (addr & 3))));
 	}
 	else
 	{
-		result = m_program->read_dword(addr);
+		result = m_program->read_dword_tlb(addr);
 	}
 
 	return result;
@@ -1187,7 +1187,7 @@ UINT16 arm7_cpu_device::arm7_cpu_read16(UINT32 addr)
 		}
 	}
 
-	result = m_program->read_word(addr & ~1);
+	result = m_program->read_word_tlb(addr & ~1);
 
 	if (addr & 1)
 	{
@@ -1208,7 +1208,7 @@ UINT8 arm7_cpu_device::arm7_cpu_read8(UINT32 addr)
 	}
 
 	// Handle through normal 8 bit handler (for 32 bit cpu)
-	return m_program->read_byte(addr);
+	return m_program->read_byte_tlb(addr);
 }
 
 #include "arm7drc.inc"
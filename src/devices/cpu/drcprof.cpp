@@ -0,0 +1,274 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    drcprof.c
+
+    Persistent block profiles for dynamic recompiling CPU cores.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcprof.h"
+#include "coreutil.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// file header
+static const char PROFILE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 'P' };
+static const UINT32 PROFILE_VERSION = 1;
+
+// size of one serialized entry: mode, pc, hash
+static const UINT32 PROFILE_ENTRY_SIZE = 12;
+
+
+
+//**************************************************************************
+//  DRC BLOCK PROFILE
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_block_profile - constructor
+//-------------------------------------------------
+
+drc_block_profile::drc_block_profile(drcuml_state &drcuml, drc_frontend &frontend, compile_delegate compile)
+	: m_device(drcuml.device()),
+		m_drcuml(drcuml),
+		m_frontend(frontend),
+		m_compile(compile),
+		m_enabled(m_device.mconfig().options().drc_cache()),
+		m_prewarming(false),
+		m_dirty(false)
+{
+}
+
+
+//-------------------------------------------------
+//  ~drc_block_profile - destructor
+//-------------------------------------------------
+
+drc_block_profile::~drc_block_profile()
+{
+}
+
+
+//-------------------------------------------------
+//  filename - return the name of the profile
+//  file for our device
+//-------------------------------------------------
+
+std::string drc_block_profile::filename() const
+{
+	std::string tag(m_device.tag());
+	tag.erase(0, 1);
+	strreplacechr(tag, ':', '_');
+	return string_format("%s" PATH_SEPARATOR "%s.drc", m_device.machine().basename(), tag);
+}
+
+
+//-------------------------------------------------
+//  load - read the profile recorded by a
+//  previous session, if any
+//-------------------------------------------------
+
+void drc_block_profile::load()
+{
+	if (!m_enabled)
+		return;
+
+	emu_file file(m_device.machine().options().drc_cache_directory(), OPEN_FLAG_READ);
+	if (file.open(filename().c_str()) != osd_file::error::NONE)
+		return;
+
+	// validate the header
+	UINT8 header[16];
+	if (file.read(header, sizeof(header)) != sizeof(header) || memcmp(header, PROFILE_MAGIC, sizeof(PROFILE_MAGIC)) != 0 || get_le32(&header[8]) != PROFILE_VERSION)
+	{
+		osd_printf_verbose("%s: ignoring invalid DRC profile '%s'\n", m_device.tag(), file.filename());
+		return;
+	}
+
+	// read all the entries
+	UINT32 count = MIN(get_le32(&header[12]), MAX_BLOCKS);
+	for (UINT32 entry = 0; entry < count; entry++)
+	{
+		UINT8 data[PROFILE_ENTRY_SIZE];
+		if (file.read(data, sizeof(data)) != sizeof(data))
+			break;
+		m_blocks[make_key(get_le32(&data[0]), get_le32(&data[4]))] = get_le32(&data[8]);
+	}
+	m_dirty = false;
+	osd_printf_verbose("%s: loaded %d block(s) from DRC profile '%s'\n", m_device.tag(), UINT32(m_blocks.size()), file.filename());
+}
+
+
+//-------------------------------------------------
+//  save - write the profile out for the next
+//  session
+//-------------------------------------------------
+
+void drc_block_profile::save()
+{
+	if (!m_enabled || !m_dirty)
+		return;
+
+	emu_file file(m_device.machine().options().drc_cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename().c_str()) != osd_file::error::NONE)
+		return;
+
+	// write the header
+	UINT8 header[16];
+	memcpy(header, PROFILE_MAGIC, sizeof(PROFILE_MAGIC));
+	put_le32(&header[8], PROFILE_VERSION);
+	put_le32(&header[12], m_blocks.size());
+	file.write(header, sizeof(header));
+
+	// then the entries, in mode/PC order
+	for (auto &block : m_blocks)
+	{
+		UINT8 data[PROFILE_ENTRY_SIZE];
+		put_le32(&data[0], block.first >> 32);
+		put_le32(&data[4], block.first & 0xffffffff);
+		put_le32(&data[8], block.second);
+		file.write(data, sizeof(data));
+	}
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  record - note that a block was compiled from
+//  the given description list
+//-------------------------------------------------
+
+void drc_block_profile::record(UINT8 mode, offs_t pc, const opcode_desc *desclist)
+{
+	if (!m_enabled)
+		return;
+
+	UINT64 key = make_key(mode, pc);
+	UINT32 hash = code_hash(desclist);
+	auto found = m_blocks.find(key);
+	if (found != m_blocks.end())
+	{
+		if (found->second != hash)
+		{
+			found->second = hash;
+			m_dirty = true;
+		}
+	}
+	else if (m_blocks.size() < MAX_BLOCKS)
+	{
+		m_blocks.emplace(key, hash);
+		m_dirty = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  prewarm - compile all recorded blocks on the
+//  same page as a block we just compiled
+//-------------------------------------------------
+
+void drc_block_profile::prewarm(UINT8 mode, offs_t pc)
+{
+	if (!m_enabled || m_prewarming)
+		return;
+
+	// copy out the candidates first; compiling may record new blocks
+	std::vector<std::pair<UINT64, UINT32>> candidates;
+	auto end = m_blocks.lower_bound(make_key(mode, (pc | PAGE_MASK)) + 1);
+	for (auto block = m_blocks.lower_bound(make_key(mode, pc & ~PAGE_MASK)); block != end; ++block)
+		candidates.push_back(*block);
+
+	m_prewarming = true;
+	for (auto &block : candidates)
+		validate_and_compile(block.first >> 32, block.first & 0xffffffff, block.second);
+	m_prewarming = false;
+}
+
+
+//-------------------------------------------------
+//  prewarm_all - compile every recorded block in
+//  the given mode whose guest code is still
+//  present; called after the cache has been
+//  flushed
+//-------------------------------------------------
+
+void drc_block_profile::prewarm_all(UINT8 mode)
+{
+	if (!m_enabled || m_prewarming)
+		return;
+
+	std::vector<std::pair<UINT64, UINT32>> candidates(m_blocks.lower_bound(make_key(mode, 0)), m_blocks.lower_bound(make_key(mode + 1, 0)));
+	if (candidates.empty())
+		return;
+	drccodeptr lasttop = m_drcuml.cache().top();
+	UINT32 compiled = 0;
+
+	m_prewarming = true;
+	for (auto &block : candidates)
+	{
+		if (validate_and_compile(block.first >> 32, block.first & 0xffffffff, block.second))
+		{
+			// if the cache top went backwards, we overflowed and flushed; stop here
+			if (m_drcuml.cache().top() < lasttop)
+				break;
+			lasttop = m_drcuml.cache().top();
+			compiled++;
+		}
+	}
+	m_prewarming = false;
+	osd_printf_verbose("%s: prewarmed %d of %d profiled DRC block(s)\n", m_device.tag(), compiled, UINT32(candidates.size()));
+}
+
+
+//-------------------------------------------------
+//  validate_and_compile - compile a recorded
+//  block if it is not already present and the
+//  guest code still matches
+//-------------------------------------------------
+
+bool drc_block_profile::validate_and_compile(UINT8 mode, offs_t pc, UINT32 hash)
+{
+	if (m_drcuml.hash_exists(mode, pc))
+		return false;
+	if (code_hash(m_frontend.describe_code(pc)) != hash)
+		return false;
+	m_compile(mode, pc);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  code_hash - compute a hash of the guest code
+//  and front-end analysis for a block
+//-------------------------------------------------
+
+UINT32 drc_block_profile::code_hash(const opcode_desc *desclist)
+{
+	crc32_creator crc;
+	for (const opcode_desc *desc = desclist; desc != nullptr; desc = desc->next())
+	{
+		hash_one(crc, *desc);
+		for (const opcode_desc *delay = desc->delay.first(); delay != nullptr; delay = delay->next())
+			hash_one(crc, *delay);
+	}
+	return crc.finish();
+}
+
+
+//-------------------------------------------------
+//  hash_one - append a single description to
+//  a running hash
+//-------------------------------------------------
+
+void drc_block_profile::hash_one(crc32_creator &crc, const opcode_desc &desc)
+{
+	UINT32 info[4] = { desc.pc, desc.physpc, desc.flags, desc.length };
+	crc.append(info, sizeof(info));
+	crc.append(desc.opptr.b, MIN(desc.length, sizeof(desc.opptr.b)));
+}
@@ -0,0 +1,98 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    drcprof.h
+
+    Persistent block profiles for dynamic recompiling CPU cores.
+
+****************************************************************************
+
+    Concepts:
+
+    Native code emitted by the back-ends is full of absolute host
+    pointers (C helpers, the near cache, handles, hash tables), so it
+    cannot be written out and reloaded in a later session. What can be
+    persisted is the knowledge of *which* blocks were compiled: for each
+    block we record the mode and PC it was compiled for, plus a hash of
+    the guest code bytes the front-end described at that PC.
+
+    On the next run the profile is loaded at startup. Whenever the
+    recompiler has to stop for a cache miss anyway, every recorded
+    block on the same guest page whose code still hashes identically is
+    compiled in the same stop, and after a cache flush every recorded
+    block for the current mode whose code is present is compiled before
+    execution resumes.
+    This turns the long tail of small compile stalls during warm-up
+    into a few batched ones, and blocks whose guest code changed are
+    simply skipped.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCPROF_H__
+#define __DRCPROF_H__
+
+#include <map>
+
+#include "drcfe.h"
+#include "drcuml.h"
+#include "hashing.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// drc_block_profile
+class drc_block_profile
+{
+public:
+	// callback used to compile a block at a given mode/PC
+	typedef delegate<void (UINT8, offs_t)> compile_delegate;
+
+	// construction/destruction
+	drc_block_profile(drcuml_state &drcuml, drc_frontend &frontend, compile_delegate compile);
+	~drc_block_profile();
+
+	// getters
+	bool enabled() const { return m_enabled; }
+	UINT32 count() const { return m_blocks.size(); }
+
+	// file management
+	void load();
+	void save();
+
+	// recording and replay
+	void record(UINT8 mode, offs_t pc, const opcode_desc *desclist);
+	void prewarm(UINT8 mode, offs_t pc);
+	void prewarm_all(UINT8 mode);
+
+private:
+	// largest number of blocks we keep per device
+	static const UINT32 MAX_BLOCKS = 65536;
+
+	// granularity used to cluster blocks around a miss
+	static const offs_t PAGE_MASK = 0xfff;
+
+	// internal helpers
+	static UINT64 make_key(UINT32 mode, offs_t pc) { return (UINT64(mode) << 32) | pc; }
+	static UINT32 code_hash(const opcode_desc *desclist);
+	static void hash_one(crc32_creator &crc, const opcode_desc &desc);
+	std::string filename() const;
+	bool validate_and_compile(UINT8 mode, offs_t pc, UINT32 hash);
+
+	// internal state
+	device_t &                  m_device;           // CPU device we are associated with
+	drcuml_state &              m_drcuml;           // UML state used to check for existing code
+	drc_frontend &              m_frontend;         // front-end used to describe code
+	compile_delegate            m_compile;          // compiler callback
+	bool                        m_enabled;          // is profiling enabled?
+	bool                        m_prewarming;       // are we currently prewarming?
+	bool                        m_dirty;            // has the profile changed since load?
+	std::map<UINT64, UINT32>    m_blocks;           // mode/PC -> guest code hash
+};
+
+
+#endif /* __DRCPROF_H__ */
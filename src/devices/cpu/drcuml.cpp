@@ -125,7 +125,12 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
-		m_umllog(nullptr)
+		m_umllog(nullptr),
+		m_async_allowed(device.machine().options().drc_async()),
+		m_async_queue(nullptr),
+		m_async_item(nullptr),
+		m_async_block(nullptr),
+		m_async_aborted(false)
 {
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
@@ -142,6 +147,12 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 
 drcuml_state::~drcuml_state()
 {
+	// finish any block in flight and shut down the worker
+	if (m_async_item != nullptr)
+		async_wait();
+	if (m_async_queue != nullptr)
+		osd_work_queue_free(m_async_queue);
+
 	// close any files
 	if (m_umllog != nullptr)
 		fclose(m_umllog);
@@ -155,6 +166,10 @@ drcuml_state::~drcuml_state()
 
 void drcuml_state::reset()
 {
+	// never flush underneath a block in flight
+	if (m_async_item != nullptr)
+		async_wait();
+
 	// if we error here, we are screwed
 	try
 	{
@@ -208,6 +223,93 @@ drcuml_block *drcuml_state::begin_block(UINT32 maxinst)
 }
 
 
+//-------------------------------------------------
+//  end_block_async - complete a code block on a
+//  worker thread; the caller must not touch the
+//  cache or execute generated code until
+//  async_wait() has returned
+//-------------------------------------------------
+
+void drcuml_state::end_block_async(drcuml_block &block)
+{
+	assert(m_async_item == nullptr);
+
+	// fall back to doing it inline if not allowed
+	if (!m_async_allowed)
+	{
+		block.end();
+		return;
+	}
+
+	// lazily create our queue the first time through
+	if (m_async_queue == nullptr)
+		m_async_queue = osd_work_queue_alloc(0);
+
+	m_async_block = &block;
+	m_async_aborted = false;
+	m_async_item = osd_work_item_queue(m_async_queue, async_end_block, this, 0);
+
+	// if we couldn't queue it, do it inline
+	if (m_async_item == nullptr)
+	{
+		m_async_block = nullptr;
+		block.end();
+	}
+}
+
+
+//-------------------------------------------------
+//  async_pending - return true if a block is
+//  still being generated on the worker
+//-------------------------------------------------
+
+bool drcuml_state::async_pending()
+{
+	return (m_async_item != nullptr && !osd_work_item_wait(m_async_item, 0));
+}
+
+
+//-------------------------------------------------
+//  async_wait - wait for the block in flight to
+//  complete; returns false if it ran out of
+//  cache and must be compiled again after a
+//  flush
+//-------------------------------------------------
+
+bool drcuml_state::async_wait()
+{
+	if (m_async_item == nullptr)
+		return true;
+
+	while (!osd_work_item_wait(m_async_item, osd_ticks_per_second()))
+		;
+	osd_work_item_release(m_async_item);
+	m_async_item = nullptr;
+	m_async_block = nullptr;
+	return !m_async_aborted;
+}
+
+
+//-------------------------------------------------
+//  async_end_block - worker callback to run the
+//  optimizer and back-end for a block
+//-------------------------------------------------
+
+void *drcuml_state::async_end_block(void *param, int threadid)
+{
+	drcuml_state *drcuml = reinterpret_cast<drcuml_state *>(param);
+	try
+	{
+		drcuml->m_async_block->end();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		drcuml->m_async_aborted = true;
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  handle_alloc - allocate a new handle
 //-------------------------------------------------
@@ -179,6 +179,12 @@ public:
 	// code generation
 	drcuml_block *begin_block(UINT32 maxinst);
 
+	// asynchronous code generation
+	bool async_allowed() const { return m_async_allowed; }
+	void end_block_async(drcuml_block &block);
+	bool async_pending();
+	bool async_wait();
+
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
@@ -223,6 +229,9 @@ private:
 		std::string             m_name;             // name of the symbol
 	};
 
+	// asynchronous code generation helpers
+	static void *async_end_block(void *param, int threadid);
+
 	// internal state
 	device_t &                  m_device;           // CPU device we are associated with
 	drc_cache &                 m_cache;            // pointer to the codegen cache
@@ -232,6 +241,13 @@ private:
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+
+	// asynchronous code generation state
+	bool                        m_async_allowed;    // may blocks be ended on a worker thread?
+	osd_work_queue *            m_async_queue;      // queue for back-end work
+	osd_work_item *             m_async_item;       // work item for the block in flight
+	drcuml_block *              m_async_block;      // block in flight
+	bool                        m_async_aborted;    // did the block in flight abort?
 };
 
 
@@ -600,7 +600,7 @@ UINT8 i386_device::READ8(UINT32 ea)
 		PF_THROW(error);
 
 	address &= m_a20_mask;
-	return m_program->read_byte(address);
+	return m_program->read_byte_tlb(address);
 }
 UINT16 i386_device::READ16(UINT32 ea)
 {
@@ -615,7 +615,7 @@ UINT16 i386_device::READ16(UINT32 ea)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = m_program->read_word( address );
+		value = m_program->read_word_tlb( address );
 	}
 	return value;
 }
@@ -634,7 +634,7 @@ UINT32 i386_device::READ32(UINT32 ea)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = m_program->read_dword( address );
+		value = m_program->read_dword_tlb( address );
 	}
 	return value;
 }
@@ -658,8 +658,8 @@ UINT64 i386_device::READ64(UINT32 ea)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = (((UINT64) m_program->read_dword( address+0 )) << 0);
-		value |= (((UINT64) m_program->read_dword( address+4 )) << 32);
+		value = (((UINT64) m_program->read_dword_tlb( address+0 )) << 0);
+		value |= (((UINT64) m_program->read_dword_tlb( address+4 )) << 32);
 	}
 	return value;
 }
@@ -671,7 +671,7 @@ UINT8 i386_device::READ8PL0(UINT32 ea)
 		PF_THROW(error);
 
 	address &= m_a20_mask;
-	return m_program->read_byte(address);
+	return m_program->read_byte_tlb(address);
 }
 UINT16 i386_device::READ16PL0(UINT32 ea)
 {
@@ -686,7 +686,7 @@ UINT16 i386_device::READ16PL0(UINT32 ea)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = m_program->read_word( address );
+		value = m_program->read_word_tlb( address );
 	}
 	return value;
 }
@@ -706,7 +706,7 @@ UINT32 i386_device::READ32PL0(UINT32 ea)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		value = m_program->read_dword( address );
+		value = m_program->read_dword_tlb( address );
 	}
 	return value;
 }
@@ -726,7 +726,7 @@ void i386_device::WRITE8(UINT32 ea, UINT8 value)
 		PF_THROW(error);
 
 	address &= m_a20_mask;
-	m_program->write_byte(address, value);
+	m_program->write_byte_tlb(address, value);
 }
 void i386_device::WRITE16(UINT32 ea, UINT16 value)
 {
@@ -740,7 +740,7 @@ void i386_device::WRITE16(UINT32 ea, UINT16 value)
 			PF_THROW(error);
 
 		address &= m_a20_mask;
-		m_program->write_word(address, value);
+		m_program->write_word_tlb(address, value);
 	}
 }
 void i386_device::WRITE32(UINT32 ea, UINT32 value)
@@ -757,7 +757,7 @@ void i386_device::WRITE32(UINT32 ea, UINT32 value)
 			PF_THROW(error);
 
 		ea &= m_a20_mask;
-		m_program->write_dword(address, value);
+		m_program->write_dword_tlb(address, value);
 	}
 }
 
@@ -779,8 +779,8 @@ void i386_device::WRITE64(UINT32 ea, UINT64 value)
 			PF_THROW(error);
 
 		ea &= m_a20_mask;
-		m_program->write_dword(address+0, value & 0xffffffff);
-		m_program->write_dword(address+4, (value >> 32) & 0xffffffff);
+		m_program->write_dword_tlb(address+0, value & 0xffffffff);
+		m_program->write_dword_tlb(address+4, (value >> 32) & 0xffffffff);
 	}
 }
 
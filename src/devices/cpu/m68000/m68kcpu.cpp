@@ -1259,12 +1259,12 @@ void m68000_base_device::init8(address_space &space, address_space &ospace)
 	opcode_xor = 0;
 
 	readimm16 = m68k_readimm16_delegate(FUNC(m68000_base_device::m68008_read_immediate_16), this);
-	read8 = m68k_read8_delegate(FUNC(address_space::read_byte), &space);
-	read16 = m68k_read16_delegate(FUNC(address_space::read_word), &space);
-	read32 = m68k_read32_delegate(FUNC(address_space::read_dword), &space);
-	write8 = m68k_write8_delegate(FUNC(address_space::write_byte), &space);
-	write16 = m68k_write16_delegate(FUNC(address_space::write_word), &space);
-	write32 = m68k_write32_delegate(FUNC(address_space::write_dword), &space);
+	read8 = m68k_read8_delegate(FUNC(address_space::read_byte_tlb), &space);
+	read16 = m68k_read16_delegate(FUNC(address_space::read_word_tlb), &space);
+	read32 = m68k_read32_delegate(FUNC(address_space::read_dword_tlb), &space);
+	write8 = m68k_write8_delegate(FUNC(address_space::write_byte_tlb), &space);
+	write16 = m68k_write16_delegate(FUNC(address_space::write_word_tlb), &space);
+	write32 = m68k_write32_delegate(FUNC(address_space::write_dword_tlb), &space);
 }
 
 /****************************************************************************
@@ -1298,12 +1298,12 @@ void m68000_base_device::init16(address_space &space, address_space &ospace)
 	opcode_xor = 0;
 
 	readimm16 = m68k_readimm16_delegate(FUNC(m68000_base_device::simple_read_immediate_16), this);
-	read8 = m68k_read8_delegate(FUNC(address_space::read_byte), &space);
-	read16 = m68k_read16_delegate(FUNC(address_space::read_word), &space);
-	read32 = m68k_read32_delegate(FUNC(address_space::read_dword), &space);
+	read8 = m68k_read8_delegate(FUNC(address_space::read_byte_tlb), &space);
+	read16 = m68k_read16_delegate(FUNC(address_space::read_word_tlb), &space);
+	read32 = m68k_read32_delegate(FUNC(address_space::read_dword_tlb), &space);
 	write8 = m68k_write8_delegate(FUNC(m68000_base_device::m68000_write_byte), this);
-	write16 = m68k_write16_delegate(FUNC(address_space::write_word), &space);
-	write32 = m68k_write32_delegate(FUNC(address_space::write_dword), &space);
+	write16 = m68k_write16_delegate(FUNC(address_space::write_word_tlb), &space);
+	write32 = m68k_write32_delegate(FUNC(address_space::write_dword_tlb), &space);
 }
 
 
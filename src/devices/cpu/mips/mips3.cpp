@@ -159,6 +159,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_drcfe(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
+	, m_compile_async(0)
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
@@ -198,6 +199,11 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 
 void mips3_device::device_stop()
 {
+	if (m_drcprof != nullptr)
+	{
+		m_drcprof->save();
+		m_drcprof = nullptr;
+	}
 	if (m_drcfe != nullptr)
 	{
 		m_drcfe = nullptr;
@@ -384,6 +390,10 @@ void mips3_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the block profile from the previous session, if enabled */
+	m_drcprof = std::make_unique<drc_block_profile>(*m_drcuml, *m_drcfe, drc_block_profile::compile_delegate(FUNC(mips3_device::code_compile_block), this));
+	m_drcprof->load();
+
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
 
@@ -2689,38 +2699,21 @@ void mips3_device::execute_run()
 {
 	if (m_isdrc)
 	{
-		int execute_result;
-
-		/* reset the cache if dirty */
-		if (m_cache_dirty)
-			code_flush_cache();
-		m_cache_dirty = FALSE;
-
-		/* execute */
-		do
-		{
-			/* run as much as we can */
-			execute_result = m_drcuml->execute(*m_entry);
-
-			/* if we need to recompile, do it */
-			if (execute_result == EXECUTE_MISSING_CODE)
-			{
-				code_compile_block(m_core->mode, m_core->pc);
-			}
-			else if (execute_result == EXECUTE_UNMAPPED_CODE)
-			{
-				fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
-			}
-			else if (execute_result == EXECUTE_RESET_CACHE)
-			{
-				code_flush_cache();
-			}
-
-		} while (execute_result != EXECUTE_OUT_OF_CYCLES);
-
+		execute_run_drc();
 		return;
 	}
 
+	execute_run_interpreter(0);
+}
+
+/*-------------------------------------------------
+    execute_run_interpreter - run the interpreter
+    until icount drops to stop_icount and we are
+    not in a delay slot
+-------------------------------------------------*/
+
+void mips3_device::execute_run_interpreter(int stop_icount)
+{
 	/* count cycles and interrupt cycles */
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
@@ -2902,7 +2895,7 @@ void mips3_device::execute_run()
 		m_delayslot = false;
 		m_core->icount--;
 
-	} while (m_core->icount > 0 || m_nextpc != ~0);
+	} while (m_core->icount > stop_icount || m_nextpc != ~0);
 
 	m_core->icount -= m_interrupt_cycles;
 	m_interrupt_cycles = 0;
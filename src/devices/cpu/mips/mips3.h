@@ -17,6 +17,7 @@
 
 #include "divtlb.h"
 #include "cpu/drcfe.h"
+#include "cpu/drcprof.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
@@ -409,10 +410,12 @@ private:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
 	std::unique_ptr<mips3_frontend>    m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_block_profile> m_drcprof;                    /* persistent DRC block profile */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
 	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
+	UINT8               m_compile_async;              /* true to end compiled blocks on a worker thread */
 
 	/* tables */
 	UINT8               m_fpmode[4];                  /* FPU mode table */
@@ -529,6 +532,9 @@ private:
 	void save_fast_iregs(drcuml_block *block);
 	void code_flush_cache();
 	void code_compile_block(UINT8 mode, offs_t pc);
+	void code_compile_block_async(UINT8 mode, offs_t pc);
+	void execute_run_drc();
+	void execute_run_interpreter(int stop_icount);
 public:
 	void func_get_cycles();
 	void func_printf_exception();
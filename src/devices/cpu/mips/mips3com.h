@@ -51,6 +51,9 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* how many cycles the interpreter runs between checks for asynchronous compilation */
+#define ASYNC_INTERPRET_CYCLES          200
+
 /* exit codes */
 #define EXECUTE_OUT_OF_CYCLES           0
 #define EXECUTE_MISSING_CODE            1
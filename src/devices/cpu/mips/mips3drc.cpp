@@ -144,6 +144,57 @@ inline void mips3_device::save_fast_iregs(drcuml_block *block)
     CORE CALLBACKS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    execute_run_drc - execute the CPU for the
+    specified number of cycles using the DRC
+-------------------------------------------------*/
+
+void mips3_device::execute_run_drc()
+{
+	int execute_result;
+
+	/* reset the cache if dirty, then warm it up from the block profile */
+	if (m_cache_dirty)
+	{
+		code_flush_cache();
+		m_drcprof->prewarm_all(m_core->mode);
+	}
+	m_cache_dirty = FALSE;
+
+	/* execute */
+	do
+	{
+		/* run as much as we can */
+		execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			UINT8 mode = m_core->mode;
+			offs_t pc = m_core->pc;
+			if (m_drcuml->async_allowed())
+			{
+				code_compile_block_async(mode, pc);
+				if (m_core->icount <= 0)
+					execute_result = EXECUTE_OUT_OF_CYCLES;
+			}
+			else
+				code_compile_block(mode, pc);
+			m_drcprof->prewarm(mode, pc);
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+		{
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+		{
+			code_flush_cache();
+		}
+
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
 /*-------------------------------------------------
     mips3drc_set_options - configure DRC options
 -------------------------------------------------*/
@@ -372,10 +423,16 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 																							// hashjmp <mode>,nextpc,nocode
 			}
 
-			/* end the sequence */
-			block->end();
+			/* end the sequence, optionally leaving the back-end work to a worker thread */
+			if (m_compile_async)
+				drcuml->end_block_async(*block);
+			else
+				block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* remember this block for future sessions */
+			m_drcprof->record(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -385,6 +442,45 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 }
 
 
+/*-------------------------------------------------
+    code_compile_block_async - compile a block of
+    the given mode at the specified pc, running
+    the interpreter while the back-end generates
+    native code on a worker thread
+-------------------------------------------------*/
+
+void mips3_device::code_compile_block_async(UINT8 mode, offs_t pc)
+{
+	/* describe and generate UML here; only the back-end runs on the worker */
+	m_compile_async = TRUE;
+	code_compile_block(mode, pc);
+	m_compile_async = FALSE;
+
+	/* interpret in short slices until the native code is ready; the */
+	/* interpreter never touches the cache, so this is safe */
+	bool interpreted = false;
+	while (m_core->icount > 0 && m_drcuml->async_pending())
+	{
+		execute_run_interpreter(MAX(m_core->icount - ASYNC_INTERPRET_CYCLES, 0));
+		interpreted = true;
+	}
+
+	/* the interpreter doesn't track the DRC mode; recompute it from SR */
+	if (interpreted)
+	{
+		UINT32 sr = m_core->cpr[0][COP0_Status];
+		m_core->mode = (((sr & (SR_EXL | SR_ERL)) != 0) ? 0 : ((sr >> 2) & 6)) | ((sr >> 26) & 1);
+	}
+
+	/* if the worker ran out of cache space, flush and compile synchronously */
+	if (!m_drcuml->async_wait())
+	{
+		code_flush_cache();
+		code_compile_block(mode, pc);
+	}
+}
+
+
 
 /***************************************************************************
     C FUNCTION CALLBACKS
@@ -932,6 +932,10 @@ void ppc_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<ppc_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the block profile from the previous session, if enabled */
+	m_drcprof = std::make_unique<drc_block_profile>(*m_drcuml, *m_drcfe, drc_block_profile::compile_delegate(FUNC(ppc_device::code_compile_block), this));
+	m_drcprof->load();
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -1150,6 +1154,8 @@ void ppc_device::state_string_export(const device_state_entry &entry, std::strin
 
 void ppc_device::device_stop()
 {
+	if (m_drcprof != nullptr)
+		m_drcprof->save();
 }
 
 
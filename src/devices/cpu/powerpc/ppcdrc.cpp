@@ -208,9 +208,12 @@ void ppc_device::execute_run()
 {
 	int execute_result;
 
-	/* reset the cache if dirty */
+	/* reset the cache if dirty, then warm it up from the block profile */
 	if (m_cache_dirty)
+	{
 		code_flush_cache();
+		m_drcprof->prewarm_all(m_core->mode);
+	}
 	m_cache_dirty = FALSE;
 
 	/* execute */
@@ -221,7 +224,10 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
+		{
 			code_compile_block(m_core->mode, m_core->pc);
+			m_drcprof->prewarm(m_core->mode, m_core->pc);
+		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -450,6 +456,9 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* remember this block for future sessions */
+			m_drcprof->record(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -199,6 +199,8 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 
 void sh2_device::device_stop()
 {
+	if (m_drcprof != nullptr)
+		m_drcprof->save();
 }
 
 
@@ -2552,6 +2554,10 @@ void sh2_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<sh2_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
+	/* load the block profile from the previous session, if enabled */
+	m_drcprof = std::make_unique<drc_block_profile>(*m_drcuml, *m_drcfe, drc_block_profile::compile_delegate(FUNC(sh2_device::code_compile_block), this));
+	m_drcprof->load();
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
 	{
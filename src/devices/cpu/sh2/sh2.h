@@ -18,6 +18,7 @@
 #define __SH2_H__
 
 #include "cpu/drcfe.h"
+#include "cpu/drcprof.h"
 #include "cpu/drcuml.h"
 
 
@@ -221,6 +222,7 @@ private:
 	drc_cache           m_cache;                  /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
 	std::unique_ptr<sh2_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_block_profile> m_drcprof;                /* persistent DRC block profile */
 	UINT32              m_drcoptions;         /* configurable DRC options */
 
 	internal_sh2_state *m_sh2_state;
@@ -632,9 +632,12 @@ void sh2_device::execute_run_drc()
 	}
 #endif
 
-	/* reset the cache if dirty */
+	/* reset the cache if dirty, then warm it up from the block profile */
 	if (m_cache_dirty)
+	{
 		code_flush_cache();
+		m_drcprof->prewarm_all(0);
+	}
 
 	/* execute */
 	do
@@ -646,6 +649,7 @@ void sh2_device::execute_run_drc()
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
 			code_compile_block(0, m_sh2_state->pc);
+			m_drcprof->prewarm(0, m_sh2_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -766,6 +770,9 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* remember this block for future sessions */
+			m_drcprof->record(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
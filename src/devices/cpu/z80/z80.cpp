@@ -436,7 +436,7 @@ inline void z80_device::out(UINT16 port, UINT8 value)
  ***************************************************************/
 inline UINT8 z80_device::rm(UINT16 addr)
 {
-	return m_program->read_byte(addr);
+	return m_program->read_byte_tlb(addr);
 }
 
 /***************************************************************
@@ -453,7 +453,7 @@ inline void z80_device::rm16(UINT16 addr, PAIR &r)
  ***************************************************************/
 inline void z80_device::wm(UINT16 addr, UINT8 value)
 {
-	m_program->write_byte(addr, value);
+	m_program->write_byte_tlb(addr, value);
 }
 
 /***************************************************************
@@ -6,6 +6,20 @@
 
     Polygon helper routines.
 
+****************************************************************************
+
+    Tile binning:
+
+    By default each primitive is set up on the calling thread and split
+    into small scanline units that are queued as it is submitted. With
+    POLYFLAG_TILE_BINNING, triangles are instead only sorted into
+    horizontal tiles of SCANLINES_PER_TILE scanlines. Nothing is queued
+    until wait(), at which point one work item per tile performs the
+    setup and rasterization of every triangle touching that tile, in
+    submission order, once any work queued before them has finished.
+    Other primitive types flush any binned triangles before they are
+    queued, so drawing order is always preserved.
+
 ****************************************************************************
 
     Pixel model:
@@ -62,11 +76,14 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_TILE_BINNING               0x08
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
 #define TOTAL_BUCKETS                       (512 / SCANLINES_PER_BUCKET)
 #define UNITS_PER_POLY                      (100 / SCANLINES_PER_BUCKET)
+#define SCANLINES_PER_TILE                  16
+#define TOTAL_TILES                         (512 / SCANLINES_PER_TILE)
 
 
 
@@ -176,6 +193,37 @@ private:
 		extent_t            extent[SCANLINES_PER_BUCKET]; // array of scanline extents
 	};
 
+	// a triangle whose setup has been deferred to the tile workers
+	struct binned_triangle
+	{
+		polygon_info *      polygon;                // pointer to polygon
+		rectangle           cliprect;               // clipping rectangle
+		int                 paramcount;             // number of parameters
+		INT32               startscan;              // first scanline, clipped
+		INT32               stopscan;               // last scanline (exclusive), clipped
+		vertex_t            v[3];                   // vertices, sorted by Y
+	};
+
+	// the list of binned triangles touching a tile
+	struct tile_bin
+	{
+		poly_manager *      owner;                  // pointer back to the poly manager
+		int                 tilenum;                // index of this tile
+		std::vector<UINT32> triangles;              // binned triangle indices, in submission order
+		UINT64              pixels;                 // pixels rendered by the last flush
+	};
+
+	// per-triangle values shared by the immediate and binned paths
+	struct triangle_setup
+	{
+		_BaseType           dxdy_v1v2;              // slope of the short upper edge
+		_BaseType           dxdy_v1v3;              // slope of the long edge
+		_BaseType           dxdy_v2v3;              // slope of the short lower edge
+		_BaseType           param_start[_MaxParams]; // parameter values at (0,0)
+		_BaseType           param_dpdx[_MaxParams]; // parameter deltas in X
+		_BaseType           param_dpdy[_MaxParams]; // parameter deltas in Y
+	};
+
 	// class for managing an array of items
 	template<class _Type, int _Count>
 	class poly_array
@@ -225,9 +273,10 @@ private:
 	typedef poly_array<polygon_info, _MaxPolys> polygon_array;
 	typedef poly_array<_ObjectData, _MaxPolys + 1> objectdata_array;
 	typedef poly_array<work_unit, MIN(_MaxPolys * UNITS_PER_POLY, 65535)> unit_array;
+	typedef poly_array<binned_triangle, _MaxPolys> binned_array;
 
 	// round in a cross-platform consistent manner
-	inline INT32 round_coordinate(_BaseType value)
+	inline INT32 round_coordinate(_BaseType value) const
 	{
 		INT32 result = poly_floor(value);
 
@@ -239,6 +288,9 @@ private:
 	// internal helpers
 	polygon_info &polygon_alloc(int minx, int maxx, int miny, int maxy, render_delegate callback)
 	{
+		// binned triangles have to be drawn before anything submitted after them
+		flush_bins();
+
 		// wait for space in the polygon and unit arrays
 		m_polygon.wait_for_space();
 		m_unit.wait_for_space((maxy - miny) / SCANLINES_PER_BUCKET + 2);
@@ -252,8 +304,18 @@ private:
 	}
 
 	static void *work_item_callback(void *param, int threadid);
+	static void *tile_callback(void *param, int threadid);
 	void presave() { wait("pre-save"); }
 
+	// triangle helpers
+	void triangle_setup_compute(triangle_setup &setup, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3, int paramcount) const;
+	INT32 triangle_extent(extent_t &extent, const triangle_setup &setup, const vertex_t &v1, const vertex_t &v2, INT32 scanline, const rectangle &cliprect, int paramcount) const;
+
+	// tile binning
+	UINT32 bin_triangle(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3, INT32 startscan, INT32 stopscan);
+	UINT32 rasterize_binned(const binned_triangle &tri, int tilenum, int threadid);
+	void flush_bins();
+
 	// queue management
 	running_machine &   m_machine;
 	screen_device *     m_screen;
@@ -270,6 +332,11 @@ private:
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
 
+	// tile binning
+	std::unique_ptr<binned_array> m_binned;         // deferred triangles, if binning
+	tile_bin            m_bin[TOTAL_TILES];         // triangles touching each tile
+	osd_work_callback   m_tile_callback;            // tile_callback, set by bin_triangle
+
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
@@ -308,6 +375,19 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// set up the tile bins if requested
+	if (flags & POLYFLAG_TILE_BINNING)
+	{
+		m_binned = std::make_unique<binned_array>(this->machine(), *this);
+		m_tile_callback = nullptr;
+		for (int tilenum = 0; tilenum < TOTAL_TILES; tilenum++)
+		{
+			m_bin[tilenum].owner = this;
+			m_bin[tilenum].tilenum = tilenum;
+			m_bin[tilenum].pixels = 0;
+		}
+	}
+
 	// request a pre-save callback for synchronization
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
@@ -335,6 +415,19 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
+	// set up the tile bins if requested
+	if (flags & POLYFLAG_TILE_BINNING)
+	{
+		m_binned = std::make_unique<binned_array>(this->machine(), *this);
+		m_tile_callback = nullptr;
+		for (int tilenum = 0; tilenum < TOTAL_TILES; tilenum++)
+		{
+			m_bin[tilenum].owner = this;
+			m_bin[tilenum].tilenum = tilenum;
+			m_bin[tilenum].pixels = 0;
+		}
+	}
+
 	// request a pre-save callback for synchronization
 	machine().save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
 }
@@ -453,6 +546,9 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
+	// rasterize anything still sitting in the tile bins
+	flush_bins();
+
 	// wait for all pending work items to complete
 	if (m_queue != nullptr)
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
@@ -675,6 +771,10 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	if (v3yclip - v1yclip <= 0)
 		return 0;
 
+	// binned triangles are set up later by the tile workers
+	if (m_binned != nullptr)
+		return bin_triangle(cliprect, callback, paramcount, *v1, *v2, *v3, v1yclip, v3yclip);
+
 	// determine total X extents
 	_BaseType minx = v1->x;
 	_BaseType maxx = v1->x;
@@ -686,35 +786,81 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	// allocate and populate a new polygon
 	polygon_info &polygon = polygon_alloc(round_coordinate(minx), round_coordinate(maxx), v1yclip, v3yclip, callback);
 
+	// compute the slopes and parameter deltas
+	triangle_setup setup;
+	triangle_setup_compute(setup, *v1, *v2, *v3, paramcount);
+
+	// compute the X extents for each scanline
+	INT32 pixels = 0;
+	UINT32 startunit = m_unit.count();
+	INT32 scaninc = 1;
+	for (INT32 curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
+	{
+		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		UINT32 unit_index = m_unit.count();
+		work_unit &unit = m_unit.next();
+
+		// determine how much to advance to hit the next bucket
+		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+
+		// fill in the work unit basics
+		unit.polygon = &polygon;
+		unit.count_next = MIN(v3yclip - curscan, scaninc);
+		unit.scanline = curscan;
+		unit.previtem = m_unit_bucket[bucketnum];
+		m_unit_bucket[bucketnum] = unit_index;
+
+		// iterate over extents
+		for (int extnum = 0; extnum < unit.count_next; extnum++)
+			pixels += triangle_extent(unit.extent[extnum], setup, *v1, *v2, curscan + extnum, cliprect, paramcount);
+	}
+
+	// enqueue the work items
+	if (m_queue != nullptr)
+		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+	// return the total number of pixels in the triangle
+	m_triangles++;
+	m_pixels += pixels;
+	return pixels;
+}
+
+
+//-------------------------------------------------
+//  triangle_setup_compute - compute the edge
+//  slopes and parameter deltas of a triangle
+//  whose vertices are sorted by Y
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::triangle_setup_compute(triangle_setup &setup, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3, int paramcount) const
+{
 	// compute the slopes for each portion of the triangle
-	_BaseType dxdy_v1v2 = (v2->y == v1->y) ? _BaseType(0.0) : (v2->x - v1->x) / (v2->y - v1->y);
-	_BaseType dxdy_v1v3 = (v3->y == v1->y) ? _BaseType(0.0) : (v3->x - v1->x) / (v3->y - v1->y);
-	_BaseType dxdy_v2v3 = (v3->y == v2->y) ? _BaseType(0.0) : (v3->x - v2->x) / (v3->y - v2->y);
+	setup.dxdy_v1v2 = (v2.y == v1.y) ? _BaseType(0.0) : (v2.x - v1.x) / (v2.y - v1.y);
+	setup.dxdy_v1v3 = (v3.y == v1.y) ? _BaseType(0.0) : (v3.x - v1.x) / (v3.y - v1.y);
+	setup.dxdy_v2v3 = (v3.y == v2.y) ? _BaseType(0.0) : (v3.x - v2.x) / (v3.y - v2.y);
 
 	// compute parameter starting points and deltas
-	_BaseType param_start[_MaxParams];
-	_BaseType param_dpdx[_MaxParams];
-	_BaseType param_dpdy[_MaxParams];
 	if (paramcount > 0)
 	{
-		_BaseType a00 = v2->y - v3->y;
-		_BaseType a01 = v3->x - v2->x;
-		_BaseType a02 = v2->x*v3->y - v3->x*v2->y;
-		_BaseType a10 = v3->y - v1->y;
-		_BaseType a11 = v1->x - v3->x;
-		_BaseType a12 = v3->x*v1->y - v1->x*v3->y;
-		_BaseType a20 = v1->y - v2->y;
-		_BaseType a21 = v2->x - v1->x;
-		_BaseType a22 = v1->x*v2->y - v2->x*v1->y;
+		_BaseType a00 = v2.y - v3.y;
+		_BaseType a01 = v3.x - v2.x;
+		_BaseType a02 = v2.x*v3.y - v3.x*v2.y;
+		_BaseType a10 = v3.y - v1.y;
+		_BaseType a11 = v1.x - v3.x;
+		_BaseType a12 = v3.x*v1.y - v1.x*v3.y;
+		_BaseType a20 = v1.y - v2.y;
+		_BaseType a21 = v2.x - v1.x;
+		_BaseType a22 = v1.x*v2.y - v2.x*v1.y;
 		_BaseType det = a02 + a12 + a22;
 
 		if (poly_abs(det) < _BaseType(0.00001))
 		{
 			for (int paramnum = 0; paramnum < paramcount; paramnum++)
 			{
-				param_dpdx[paramnum] = _BaseType(0.0);
-				param_dpdy[paramnum] = _BaseType(0.0);
-				param_start[paramnum] = v1->p[paramnum];
+				setup.param_dpdx[paramnum] = _BaseType(0.0);
+				setup.param_dpdy[paramnum] = _BaseType(0.0);
+				setup.param_start[paramnum] = v1.p[paramnum];
 			}
 		}
 		else
@@ -722,100 +868,209 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 			_BaseType idet = poly_recip(det);
 			for (int paramnum = 0; paramnum < paramcount; paramnum++)
 			{
-				param_dpdx[paramnum]  = idet * (v1->p[paramnum]*a00 + v2->p[paramnum]*a10 + v3->p[paramnum]*a20);
-				param_dpdy[paramnum]  = idet * (v1->p[paramnum]*a01 + v2->p[paramnum]*a11 + v3->p[paramnum]*a21);
-				param_start[paramnum] = idet * (v1->p[paramnum]*a02 + v2->p[paramnum]*a12 + v3->p[paramnum]*a22);
+				setup.param_dpdx[paramnum]  = idet * (v1.p[paramnum]*a00 + v2.p[paramnum]*a10 + v3.p[paramnum]*a20);
+				setup.param_dpdy[paramnum]  = idet * (v1.p[paramnum]*a01 + v2.p[paramnum]*a11 + v3.p[paramnum]*a21);
+				setup.param_start[paramnum] = idet * (v1.p[paramnum]*a02 + v2.p[paramnum]*a12 + v3.p[paramnum]*a22);
 			}
 		}
 	}
 	else    // GCC 4.7.0 incorrectly claims these are uninitialized; humor it by initializing in the (hopefully rare) zero parameter case
 	{
-		param_start[0] = _BaseType(0.0);
-		param_dpdx[0] = _BaseType(0.0);
-		param_dpdy[0] = _BaseType(0.0);
+		setup.param_start[0] = _BaseType(0.0);
+		setup.param_dpdx[0] = _BaseType(0.0);
+		setup.param_dpdy[0] = _BaseType(0.0);
 	}
+}
 
-	// compute the X extents for each scanline
-	INT32 pixels = 0;
-	UINT32 startunit = m_unit.count();
-	INT32 scaninc = 1;
-	for (INT32 curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
+
+//-------------------------------------------------
+//  triangle_extent - compute the extent of a
+//  set-up triangle on a single scanline,
+//  returning its width in pixels
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+INT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::triangle_extent(extent_t &extent, const triangle_setup &setup, const vertex_t &v1, const vertex_t &v2, INT32 scanline, const rectangle &cliprect, int paramcount) const
+{
+	// compute the ending X based on which part of the triangle we're in
+	_BaseType fully = _BaseType(scanline) + _BaseType(0.5);
+	_BaseType startx = v1.x + (fully - v1.y) * setup.dxdy_v1v3;
+	_BaseType stopx;
+	if (fully < v2.y)
+		stopx = v1.x + (fully - v1.y) * setup.dxdy_v1v2;
+	else
+		stopx = v2.x + (fully - v2.y) * setup.dxdy_v2v3;
+
+	// clamp to full pixels
+	INT32 istartx = round_coordinate(startx);
+	INT32 istopx = round_coordinate(stopx);
+
+	// force start < stop
+	if (istartx > istopx)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-		UINT32 unit_index = m_unit.count();
-		work_unit &unit = m_unit.next();
+		INT32 temp = istartx;
+		istartx = istopx;
+		istopx = temp;
+	}
 
-		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+	// include the right edge if requested
+	if (m_flags & POLYFLAG_INCLUDE_RIGHT_EDGE)
+		istopx++;
 
-		// fill in the work unit basics
-		unit.polygon = &polygon;
-		unit.count_next = MIN(v3yclip - curscan, scaninc);
-		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+	// apply left/right clipping
+	if (istartx < cliprect.min_x)
+		istartx = cliprect.min_x;
+	if (istopx > cliprect.max_x)
+		istopx = cliprect.max_x + 1;
 
-		// iterate over extents
-		for (int extnum = 0; extnum < unit.count_next; extnum++)
-		{
-			// compute the ending X based on which part of the triangle we're in
-			_BaseType fully = _BaseType(curscan + extnum) + _BaseType(0.5);
-			_BaseType startx = v1->x + (fully - v1->y) * dxdy_v1v3;
-			_BaseType stopx;
-			if (fully < v2->y)
-				stopx = v1->x + (fully - v1->y) * dxdy_v1v2;
-			else
-				stopx = v2->x + (fully - v2->y) * dxdy_v2v3;
+	// set the extent
+	if (istartx >= istopx)
+		istartx = istopx = 0;
+	extent.startx = istartx;
+	extent.stopx = istopx;
+	extent.userdata = nullptr;
+
+	// fill in the parameters for the extent
+	_BaseType fullstartx = _BaseType(istartx) + _BaseType(0.5);
+	for (int paramnum = 0; paramnum < paramcount; paramnum++)
+	{
+		extent.param[paramnum].start = setup.param_start[paramnum] + fullstartx * setup.param_dpdx[paramnum] + fully * setup.param_dpdy[paramnum];
+		extent.param[paramnum].dpdx = setup.param_dpdx[paramnum];
+	}
+	return istopx - istartx;
+}
 
-			// clamp to full pixels
-			INT32 istartx = round_coordinate(startx);
-			INT32 istopx = round_coordinate(stopx);
 
-			// force start < stop
-			if (istartx > istopx)
-			{
-				INT32 temp = istartx;
-				istartx = istopx;
-				istopx = temp;
-			}
+//-------------------------------------------------
+//  bin_triangle - defer a triangle to the tile
+//  workers; returns an estimate of its pixel
+//  count since it has not been rasterized yet
+//-------------------------------------------------
 
-			// include the right edge if requested
-			if (m_flags & POLYFLAG_INCLUDE_RIGHT_EDGE)
-				istopx++;
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_triangle(const rectangle &cliprect, render_delegate callback, int paramcount, const vertex_t &v1, const vertex_t &v2, const vertex_t &v3, INT32 startscan, INT32 stopscan)
+{
+	// wait for space in the polygon and triangle arrays
+	m_polygon.wait_for_space();
+	m_binned->wait_for_space();
 
-			// apply left/right clipping
-			if (istartx < cliprect.min_x)
-				istartx = cliprect.min_x;
-			if (istopx > cliprect.max_x)
-				istopx = cliprect.max_x + 1;
+	// allocate and populate a new polygon
+	polygon_info &polygon = m_polygon.next();
+	polygon.m_owner = this;
+	polygon.m_object = &object_data_last();
+	polygon.m_callback = callback;
+
+	// remember everything needed to set it up later
+	UINT32 trinum = m_binned->count();
+	binned_triangle &tri = m_binned->next();
+	tri.polygon = &polygon;
+	tri.cliprect = cliprect;
+	tri.paramcount = paramcount;
+	tri.startscan = startscan;
+	tri.stopscan = stopscan;
+	tri.v[0] = v1;
+	tri.v[1] = v2;
+	tri.v[2] = v3;
+
+	// add it to every tile it touches
+	INT32 firsttile = (UINT32)startscan / SCANLINES_PER_TILE;
+	INT32 lasttile = (UINT32)(stopscan - 1) / SCANLINES_PER_TILE;
+	for (INT32 tile = firsttile; tile <= lasttile && tile < firsttile + TOTAL_TILES; tile++)
+		m_bin[tile % TOTAL_TILES].triangles.push_back(trinum);
+
+	// only reference the rasterizer from here, so that managers which never
+	// draw triangles (and whose base type might not support it) don't need it
+	m_tile_callback = tile_callback;
 
-			// set the extent and update the total pixel count
-			if (istartx >= istopx)
-				istartx = istopx = 0;
-			extent_t &extent = unit.extent[extnum];
-			extent.startx = istartx;
-			extent.stopx = istopx;
-			extent.userdata = nullptr;
-			pixels += istopx - istartx;
+	m_triangles++;
+	return UINT32(poly_abs((v2.x - v1.x) * (v3.y - v1.y) - (v3.x - v1.x) * (v2.y - v1.y)) * _BaseType(0.5));
+}
 
-			// fill in the parameters for the extent
-			_BaseType fullstartx = _BaseType(istartx) + _BaseType(0.5);
-			for (int paramnum = 0; paramnum < paramcount; paramnum++)
-			{
-				extent.param[paramnum].start = param_start[paramnum] + fullstartx * param_dpdx[paramnum] + fully * param_dpdy[paramnum];
-				extent.param[paramnum].dpdx = param_dpdx[paramnum];
-			}
+
+//-------------------------------------------------
+//  tile_callback - set up and rasterize all the
+//  triangles binned to a tile
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::tile_callback(void *param, int threadid)
+{
+	tile_bin &bin = *(tile_bin *)param;
+	bin.pixels = 0;
+	for (UINT32 trinum : bin.triangles)
+		bin.pixels += bin.owner->rasterize_binned((*bin.owner->m_binned)[trinum], bin.tilenum, threadid);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  rasterize_binned - set up a binned triangle
+//  and render the scanlines belonging to a tile;
+//  returns the number of pixels covered
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::rasterize_binned(const binned_triangle &tri, int tilenum, int threadid)
+{
+	UINT32 pixels = 0;
+	triangle_setup setup;
+	triangle_setup_compute(setup, tri.v[0], tri.v[1], tri.v[2], tri.paramcount);
+
+	// walk the bands of this tile that the triangle covers
+	polygon_info &polygon = *tri.polygon;
+	for (INT32 band = (UINT32)tri.startscan / SCANLINES_PER_TILE; band * SCANLINES_PER_TILE < tri.stopscan; band++)
+	{
+		if (band % TOTAL_TILES != tilenum)
+			continue;
+
+		INT32 startscan = MAX(tri.startscan, band * SCANLINES_PER_TILE);
+		INT32 stopscan = MIN(tri.stopscan, (band + 1) * SCANLINES_PER_TILE);
+		for (INT32 curscan = startscan; curscan < stopscan; curscan++)
+		{
+			extent_t extent;
+			pixels += triangle_extent(extent, setup, tri.v[0], tri.v[1], curscan, tri.cliprect, tri.paramcount);
+			polygon.m_callback(curscan, extent, *polygon.m_object, threadid);
 		}
 	}
+	return pixels;
+}
 
-	// enqueue the work items
+
+//-------------------------------------------------
+//  flush_bins - rasterize every binned triangle,
+//  one work item per tile, and wait for them
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::flush_bins()
+{
+	if (m_binned == nullptr || m_binned->count() == 0)
+		return;
+
+	// anything queued before the binned triangles has to be drawn first
 	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 
-	// return the total number of pixels in the triangle
-	m_triangles++;
-	m_pixels += pixels;
-	return pixels;
+	// queue the tiles that have anything in them
+	for (int tilenum = 0; tilenum < TOTAL_TILES; tilenum++)
+		if (!m_bin[tilenum].triangles.empty())
+		{
+			if (m_queue != nullptr)
+				osd_work_item_queue(m_queue, m_tile_callback, &m_bin[tilenum], WORK_ITEM_FLAG_AUTO_RELEASE);
+			else
+				(*m_tile_callback)(&m_bin[tilenum], 0);
+		}
+
+	// wait for them to finish, then tally and empty the bins
+	if (m_queue != nullptr)
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+	for (int tilenum = 0; tilenum < TOTAL_TILES; tilenum++)
+		if (!m_bin[tilenum].triangles.empty())
+		{
+			m_pixels += m_bin[tilenum].pixels;
+			m_bin[tilenum].triangles.clear();
+		}
+	m_binned->reset();
 }
 
 
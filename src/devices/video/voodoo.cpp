@@ -230,6 +230,61 @@ static const raster_info predef_raster_table[] =
 
 
 
+/*************************************
+ *
+ *  Generic rasterizers
+ *
+ *************************************/
+
+/*
+    Combinations of modes without a specific rasterizer fall back to
+    a generic one that reads the modes from the registers. There is
+    one variant per combination of the optional alpha test, alpha
+    blend, fog and depth buffer stages; with their enable bits fixed
+    the compiler drops every stage that is switched off.
+*/
+
+#define GENERIC_ALPHATEST       0x01
+#define GENERIC_ALPHABLEND      0x02
+#define GENERIC_FOG             0x04
+#define GENERIC_DEPTHBUF        0x08
+
+#define GENERIC_ALPHAMODE(stages)   ((vd->reg[alphaMode].u & ~0x11) | (((stages) & GENERIC_ALPHATEST) ? 0x01 : 0) | (((stages) & GENERIC_ALPHABLEND) ? 0x10 : 0))
+#define GENERIC_FOGMODE(stages)     ((vd->reg[fogMode].u & ~0x01) | (((stages) & GENERIC_FOG) ? 0x01 : 0))
+#define GENERIC_FBZMODE(stages)     ((vd->reg[fbzMode].u & ~0x10) | (((stages) & GENERIC_DEPTHBUF) ? 0x10 : 0))
+
+#define RASTERIZER_GENERIC(stages) \
+	RASTERIZER(generic_0tmu_##stages, 0, vd->reg[fbzColorPath].u, GENERIC_FBZMODE(0x##stages), GENERIC_ALPHAMODE(0x##stages), \
+				GENERIC_FOGMODE(0x##stages), 0, 0) \
+	RASTERIZER(generic_1tmu_##stages, 1, vd->reg[fbzColorPath].u, GENERIC_FBZMODE(0x##stages), GENERIC_ALPHAMODE(0x##stages), \
+				GENERIC_FOGMODE(0x##stages), vd->tmu[0].reg[textureMode].u, 0) \
+	RASTERIZER(generic_2tmu_##stages, 2, vd->reg[fbzColorPath].u, GENERIC_FBZMODE(0x##stages), GENERIC_ALPHAMODE(0x##stages), \
+				GENERIC_FOGMODE(0x##stages), vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+RASTERIZER_GENERIC(0) RASTERIZER_GENERIC(1) RASTERIZER_GENERIC(2) RASTERIZER_GENERIC(3)
+RASTERIZER_GENERIC(4) RASTERIZER_GENERIC(5) RASTERIZER_GENERIC(6) RASTERIZER_GENERIC(7)
+RASTERIZER_GENERIC(8) RASTERIZER_GENERIC(9) RASTERIZER_GENERIC(a) RASTERIZER_GENERIC(b)
+RASTERIZER_GENERIC(c) RASTERIZER_GENERIC(d) RASTERIZER_GENERIC(e) RASTERIZER_GENERIC(f)
+
+#undef RASTERIZER_GENERIC
+
+#define GENERIC_ENTRIES(tmus) \
+	{ voodoo_device::raster_generic_##tmus##tmu_0, voodoo_device::raster_generic_##tmus##tmu_1, voodoo_device::raster_generic_##tmus##tmu_2, voodoo_device::raster_generic_##tmus##tmu_3, \
+		voodoo_device::raster_generic_##tmus##tmu_4, voodoo_device::raster_generic_##tmus##tmu_5, voodoo_device::raster_generic_##tmus##tmu_6, voodoo_device::raster_generic_##tmus##tmu_7, \
+		voodoo_device::raster_generic_##tmus##tmu_8, voodoo_device::raster_generic_##tmus##tmu_9, voodoo_device::raster_generic_##tmus##tmu_a, voodoo_device::raster_generic_##tmus##tmu_b, \
+		voodoo_device::raster_generic_##tmus##tmu_c, voodoo_device::raster_generic_##tmus##tmu_d, voodoo_device::raster_generic_##tmus##tmu_e, voodoo_device::raster_generic_##tmus##tmu_f }
+
+static const poly_draw_scanline_func generic_raster_table[3][16] =
+{
+	GENERIC_ENTRIES(0),
+	GENERIC_ENTRIES(1),
+	GENERIC_ENTRIES(2)
+};
+
+#undef GENERIC_ENTRIES
+
+
+
 /***************************************************************************
     INLINE FUNCTIONS
 ***************************************************************************/
@@ -5676,8 +5731,12 @@ raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, int texcount)
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* generate a new one using the generic entry with the same stages enabled */
+	curinfo.callback = generic_raster_table[texcount][
+			(ALPHAMODE_ALPHATEST(curinfo.eff_alpha_mode) ? GENERIC_ALPHATEST : 0) |
+			(ALPHAMODE_ALPHABLEND(curinfo.eff_alpha_mode) ? GENERIC_ALPHABLEND : 0) |
+			(FOGMODE_ENABLE_FOG(curinfo.eff_fog_mode) ? GENERIC_FOG : 0) |
+			(FBZMODE_ENABLE_DEPTHBUF(curinfo.eff_fbz_mode) ? GENERIC_DEPTHBUF : 0)];
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5912,26 +5971,3 @@ void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *
 	}
 }
 
-
-/*-------------------------------------------------
-    generic_0tmu - generic rasterizer for 0 TMUs
--------------------------------------------------*/
-
-RASTERIZER(generic_0tmu, 0, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, 0, 0)
-
-
-/*-------------------------------------------------
-    generic_1tmu - generic rasterizer for 1 TMU
--------------------------------------------------*/
-
-RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, 0)
-
-
-/*-------------------------------------------------
-    generic_2tmu - generic rasterizer for 2 TMUs
--------------------------------------------------*/
-
-RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
-			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
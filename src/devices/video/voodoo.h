@@ -1821,12 +1821,20 @@ public:
 	static void cmdfifo_w(voodoo_device *vd, cmdfifo_info *f, offs_t offset, UINT32 data);
 
 	static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
 
 #define RASTERIZER_HEADER(name) \
 	static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid);
+
+	// generic rasterizers, one per combination of optional pipeline stages
+#define RASTERIZER_GENERIC_HEADERS(stages) \
+	RASTERIZER_HEADER(generic_0tmu_##stages) \
+	RASTERIZER_HEADER(generic_1tmu_##stages) \
+	RASTERIZER_HEADER(generic_2tmu_##stages)
+	RASTERIZER_GENERIC_HEADERS(0) RASTERIZER_GENERIC_HEADERS(1) RASTERIZER_GENERIC_HEADERS(2) RASTERIZER_GENERIC_HEADERS(3)
+	RASTERIZER_GENERIC_HEADERS(4) RASTERIZER_GENERIC_HEADERS(5) RASTERIZER_GENERIC_HEADERS(6) RASTERIZER_GENERIC_HEADERS(7)
+	RASTERIZER_GENERIC_HEADERS(8) RASTERIZER_GENERIC_HEADERS(9) RASTERIZER_GENERIC_HEADERS(a) RASTERIZER_GENERIC_HEADERS(b)
+	RASTERIZER_GENERIC_HEADERS(c) RASTERIZER_GENERIC_HEADERS(d) RASTERIZER_GENERIC_HEADERS(e) RASTERIZER_GENERIC_HEADERS(f)
+#undef RASTERIZER_GENERIC_HEADERS
 #define RASTERIZER_ENTRY(fbzcp, alpha, fog, fbz, tex0, tex1) \
 	RASTERIZER_HEADER(fbzcp##_##alpha##_##fog##_##fbz##_##tex0##_##tex1)
 #include "voodoo_rast.inc"
@@ -50,7 +50,9 @@ public:
 	void reset() { m_total = m_matches = m_nonroms = 0; }
 	void identify(const char *name);
 	void identify_file(const char *name);
-	void identify_data(const char *name, const UINT8 *data, int length);
+	void identify_data(const char *name, const UINT8 *data, int length, const std::string &cachekey = std::string(), INT64 modified = 0);
+	void identify_hashes(const char *name, const hash_collection &hashes, int length);
+	bool identify_cached(const char *name, const std::string &cachekey, UINT64 length, INT64 modified);
 	int find_by_hash(const hash_collection &hashes, int length);
 
 private:
@@ -189,6 +191,10 @@ int cli_frontend::execute(int argc, char **argv)
 		if (!option_errors.empty())
 			osd_printf_error("Error in command line:\n%s\n", strtrimspace(option_errors).c_str());
 
+		// pick up the file hashes saved by a previous run
+		if (m_options.hash_cache())
+			file_hash_cache::load(m_options.hash_cache_directory());
+
 		// determine the base name of the EXE
 		std::string exename = core_filename_extract_base(argv[0], true);
 
@@ -266,6 +272,7 @@ int cli_frontend::execute(int argc, char **argv)
 	}
 
 	util::archive_file::cache_clear();
+	file_hash_cache::save();
 	global_free(manager);
 
 	return m_result;
@@ -286,6 +293,8 @@ void cli_frontend::listxml(const char *gamename)
 
 	// create the XML and print it to stdout
 	info_xml_creator creator(drivlist);
+	creator.set_parallel(m_options.parallel());
+	creator.set_compact(m_options.compact_xml());
 	creator.output(stdout);
 }
 
@@ -742,6 +751,88 @@ void cli_frontend::listmedia(const char *gamename)
 	}
 }
 
+//-------------------------------------------------
+//  verifyroms_chunk_callback - audit a run of
+//  drivers on a worker thread with a private
+//  enumerator and auditor
+//-------------------------------------------------
+
+struct verifyroms_result
+{
+	media_auditor::summary          summary;
+	std::string                     text;
+};
+
+struct verifyroms_chunk
+{
+	cli_options *                   options;
+	const std::vector<int> *        drivers;
+	std::vector<verifyroms_result> *results;
+	int                             start;
+	int                             end;
+};
+
+static void *verifyroms_chunk_callback(void *param, int threadid)
+{
+	verifyroms_chunk &chunk = *reinterpret_cast<verifyroms_chunk *>(param);
+
+	// build an enumerator covering just our drivers
+	driver_enumerator drivlist(*chunk.options);
+	drivlist.exclude_all();
+	for (int index = chunk.start; index < chunk.end; index++)
+		drivlist.include((*chunk.drivers)[index]);
+
+	// audit them in order, capturing the summaries for later output
+	media_auditor auditor(drivlist);
+	for (int index = chunk.start; drivlist.next(); index++)
+	{
+		verifyroms_result &result = (*chunk.results)[index];
+		result.summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+		if (result.summary != media_auditor::NOTFOUND)
+			auditor.summarize(drivlist.driver().name, &result.text);
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  verifyroms_parallel - audit all drivers
+//  matching a name across the worker threads;
+//  results are stored in enumeration order
+//-------------------------------------------------
+
+static void verifyroms_parallel(cli_options &options, const char *gamename, std::vector<verifyroms_result> &results)
+{
+	const int CHUNK_SIZE = 32;
+
+	// gather the matching drivers
+	driver_enumerator drivlist(options, gamename);
+	std::vector<int> drivers;
+	while (drivlist.next())
+		drivers.push_back(drivlist.current());
+	results.resize(drivers.size());
+
+	// carve them into chunks small enough to balance well
+	std::vector<verifyroms_chunk> chunks;
+	for (int start = 0; start < int(drivers.size()); start += CHUNK_SIZE)
+		chunks.push_back({ &options, &drivers, &results, start, MIN(start + CHUNK_SIZE, int(drivers.size())) });
+	if (chunks.empty())
+		return;
+
+	// run them on a work queue if we can get one, otherwise just inline
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue == nullptr)
+	{
+		for (verifyroms_chunk &chunk : chunks)
+			verifyroms_chunk_callback(&chunk, 0);
+		return;
+	}
+	osd_work_item_queue_multiple(queue, verifyroms_chunk_callback, chunks.size(), &chunks[0], sizeof(chunks[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, 100 * osd_ticks_per_second())) { }
+	osd_work_queue_free(queue);
+}
+
+
 //-------------------------------------------------
 //  verifyroms - verify the ROM sets of one or
 //  more games
@@ -756,14 +847,27 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
+	// if requested, audit everything up front across multiple threads
+	std::vector<verifyroms_result> results;
+	if (m_options.parallel())
+		verifyroms_parallel(m_options, gamename, results);
+
 	// iterate over drivers
 	media_auditor auditor(drivlist);
 	while (drivlist.next())
 	{
 		matched++;
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+		// audit the ROMs in this set, or pick up the result from above
+		media_auditor::summary summary;
+		std::string summary_string;
+		if (!results.empty())
+		{
+			summary = results[matched - 1].summary;
+			summary_string = std::move(results[matched - 1].text);
+		}
+		else
+			summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
 
 		// if not found, count that and leave it at that
 		if (summary == media_auditor::NOTFOUND)
@@ -773,8 +877,8 @@ void cli_frontend::verifyroms(const char *gamename)
 		else
 		{
 			// output the summary of the audit
-			std::string summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
+			if (results.empty())
+				auditor.summarize(drivlist.driver().name,&summary_string);
 			osd_printf_info("%s", summary_string.c_str());
 
 			// output the name of the driver and its clone
@@ -1599,6 +1703,7 @@ void cli_frontend::execute_commands(const char *exename)
 	if (strcmp(m_options.command(), CLICOMMAND_VALIDATE) == 0)
 	{
 		validity_checker valid(m_options);
+		valid.set_parallel(m_options.parallel());
 		const char *sysname = m_options.system_name();
 		bool result = valid.check_all_matching((sysname[0] == 0) ? "*" : sysname);
 		if (!result)
@@ -1785,19 +1890,28 @@ void media_identifier::identify(const char *filename)
 		{
 			std::vector<std::uint8_t> data;
 
+			// members are only looked up in the hash cache while the archive itself is unchanged
+			std::unique_ptr<osd_directory_entry, void (*)(void *)> archiveinfo(osd_stat(filename), &osd_free);
+			INT64 const modified = archiveinfo ? archiveinfo->last_modified : 0;
+
 			// loop over entries in the .7z, skipping empty files and directories
 			for (int i = archive->first_file(); i >= 0; i = archive->next_file())
 			{
 				const std::uint64_t length(archive->current_uncompressed_length());
 				if (!archive->current_is_directory() && (length != 0) && (std::uint32_t(length) == length))
 				{
+					// skip decompressing entirely if we already know the hashes
+					std::string const cachekey = file_hash_cache::make_key(filename, archive->current_name().c_str());
+					if (identify_cached(archive->current_name().c_str(), cachekey, length, modified))
+						continue;
+
 					// decompress data into RAM and identify it
 					try
 					{
 						data.resize(std::size_t(length));
 						err = archive->decompress(&data[0], std::uint32_t(length));
 						if (err == util::archive_file::error::NONE)
-							identify_data(archive->current_name().c_str(), &data[0], length);
+							identify_data(archive->current_name().c_str(), &data[0], length, cachekey, modified);
 					}
 					catch (...)
 					{
@@ -1865,26 +1979,52 @@ void media_identifier::identify_file(const char *name)
 	// all other files have their hashes computed directly
 	else
 	{
+		// skip reading the file entirely if we already know the hashes
+		std::unique_ptr<osd_directory_entry, void (*)(void *)> info(osd_stat(name), &osd_free);
+		std::string const cachekey = file_hash_cache::make_key(name);
+		if (info && info->size > 0 && identify_cached(name, cachekey, info->size, info->last_modified))
+			return;
+
 		// load the file and process if it opens and has a valid length
 		UINT32 length;
 		void *data;
 		const osd_file::error filerr = util::core_file::load(name, &data, length);
 		if (filerr == osd_file::error::NONE && length > 0)
 		{
-			identify_data(name, reinterpret_cast<UINT8 *>(data), length);
+			identify_data(name, reinterpret_cast<UINT8 *>(data), length, cachekey, info ? info->last_modified : 0);
 			osd_free(data);
 		}
 	}
 }
 
 
+//-------------------------------------------------
+//  identify_cached - identify a file using the
+//  hashes remembered from an earlier run, if the
+//  file is unchanged since
+//-------------------------------------------------
+
+bool media_identifier::identify_cached(const char *name, const std::string &cachekey, UINT64 length, INT64 modified)
+{
+	// .jed files are hashed after conversion, so never come from the cache
+	if (modified == 0 || core_filename_ends_with(name, ".jed"))
+		return false;
+
+	hash_collection hashes;
+	if (!file_hash_cache::find(cachekey, length, modified, hash_collection::HASH_TYPES_CRC_SHA1, hashes))
+		return false;
+	identify_hashes(name, hashes, length);
+	return true;
+}
+
+
 //-------------------------------------------------
 //  identify_data - identify a buffer full of
 //  data; if it comes from a .JED file, parse the
 //  fusemap into raw data first
 //-------------------------------------------------
 
-void media_identifier::identify_data(const char *name, const UINT8 *data, int length)
+void media_identifier::identify_data(const char *name, const UINT8 *data, int length, const std::string &cachekey, INT64 modified)
 {
 	// if this is a '.jed' file, process it into raw bits first
 	dynamic_buffer tempjed;
@@ -1898,10 +2038,22 @@ void media_identifier::identify_data(const char *name, const UINT8 *data, int le
 		data = &tempjed[0];
 	}
 
-	// compute the hash of the data
+	// compute the hash of the data, remembering it for next time if it's the raw file contents
 	hash_collection hashes;
 	hashes.compute(data, length, hash_collection::HASH_TYPES_CRC_SHA1);
+	if (!cachekey.empty() && modified != 0 && tempjed.empty())
+		file_hash_cache::add(cachekey, length, modified, hashes);
+	identify_hashes(name, hashes, length);
+}
 
+
+//-------------------------------------------------
+//  identify_hashes - report the drivers that use
+//  a file with the given hashes
+//-------------------------------------------------
+
+void media_identifier::identify_hashes(const char *name, const hash_collection &hashes, int length)
+{
 	// output the name
 	m_total++;
 	osd_printf_info("%-20s", core_filename_extract_base(name).c_str());
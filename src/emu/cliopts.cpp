@@ -46,6 +46,11 @@ const options_entry cli_options::s_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTWARE ";vsoft", "0",     OPTION_COMMAND,    "verify known software for the system" },
 	{ CLICOMMAND_GETSOFTLIST ";glist",  "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist", "0",     OPTION_COMMAND,    "verify software list by name" },
+
+	/* frontend command options */
+	{ nullptr,                            nullptr,       OPTION_HEADER,     "FRONTEND COMMAND OPTIONS" },
+	{ CLIOPTION_PARALLEL ";par",        "0",       OPTION_BOOLEAN,    "spread the work of supported frontend commands across multiple threads" },
+	{ CLIOPTION_COMPACTXML ";cx",       "0",       OPTION_BOOLEAN,    "leave the DTD and indentation out of -listxml output" },
 	{ nullptr }
 };
 
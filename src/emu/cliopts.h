@@ -48,6 +48,10 @@
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
 
+// frontend command options
+#define CLIOPTION_PARALLEL              "parallel"
+#define CLIOPTION_COMPACTXML            "compactxml"
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -60,6 +64,10 @@ public:
 	// construction/destruction
 	cli_options();
 
+	// frontend command options
+	bool parallel() const { return bool_value(CLIOPTION_PARALLEL); }
+	bool compact_xml() const { return bool_value(CLIOPTION_COMPACTXML); }
+
 private:
 	static const options_entry s_option_entries[];
 };
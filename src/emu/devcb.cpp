@@ -250,6 +250,7 @@ UINT64 devcb_read_base::read_unresolved_adapter(address_space &space, offs_t off
 
 UINT64 devcb_read_base::read_line_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_readline() & 1);
 }
 
@@ -260,6 +261,7 @@ UINT64 devcb_read_base::read_line_adapter(address_space &space, offs_t offset, U
 
 UINT64 devcb_read_base::read8_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_read8(space, offset, unshift_mask(mask)));
 }
 
@@ -270,6 +272,7 @@ UINT64 devcb_read_base::read8_adapter(address_space &space, offs_t offset, UINT6
 
 UINT64 devcb_read_base::read16_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_read16(space, offset, unshift_mask(mask)));
 }
 
@@ -280,6 +283,7 @@ UINT64 devcb_read_base::read16_adapter(address_space &space, offs_t offset, UINT
 
 UINT64 devcb_read_base::read32_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_read32(space, offset, unshift_mask(mask)));
 }
 
@@ -290,6 +294,7 @@ UINT64 devcb_read_base::read32_adapter(address_space &space, offs_t offset, UINT
 
 UINT64 devcb_read_base::read64_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_read64(space, offset, unshift_mask(mask)));
 }
 
@@ -300,6 +305,7 @@ UINT64 devcb_read_base::read64_adapter(address_space &space, offs_t offset, UINT
 
 UINT64 devcb_read_base::read_ioport_adapter(address_space &space, offs_t offset, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	return shift_mask_xor(m_target.ioport->read());
 }
 
@@ -470,6 +476,7 @@ void devcb_write_base::write_unresolved_adapter(address_space &space, offs_t off
 
 void devcb_write_base::write_line_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_writeline(unshift_mask_xor(data) & 1);
 }
 
@@ -480,6 +487,7 @@ void devcb_write_base::write_line_adapter(address_space &space, offs_t offset, U
 
 void devcb_write_base::write8_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_write8(space, offset, unshift_mask_xor(data), unshift_mask(mask));
 }
 
@@ -490,6 +498,7 @@ void devcb_write_base::write8_adapter(address_space &space, offs_t offset, UINT6
 
 void devcb_write_base::write16_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_write16(space, offset, unshift_mask_xor(data), unshift_mask(mask));
 }
 
@@ -500,6 +509,7 @@ void devcb_write_base::write16_adapter(address_space &space, offs_t offset, UINT
 
 void devcb_write_base::write32_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_write32(space, offset, unshift_mask_xor(data), unshift_mask(mask));
 }
 
@@ -510,6 +520,7 @@ void devcb_write_base::write32_adapter(address_space &space, offs_t offset, UINT
 
 void devcb_write_base::write64_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_write64(space, offset, unshift_mask_xor(data), unshift_mask(mask));
 }
 
@@ -520,6 +531,7 @@ void devcb_write_base::write64_adapter(address_space &space, offs_t offset, UINT
 
 void devcb_write_base::write_ioport_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	if (m_target.ioport)
 		m_target.ioport->write(unshift_mask_xor(data));
 }
@@ -553,5 +565,6 @@ void devcb_write_base::write_noop_adapter(address_space &space, offs_t offset, U
 
 void devcb_write_base::write_inputline_adapter(address_space &space, offs_t offset, UINT64 data, UINT64 mask)
 {
+	device_scheduler::group_sync sync;
 	m_target.device->execute().set_input_line(m_target_int, unshift_mask_xor(data) & 1);
 }
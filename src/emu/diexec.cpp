@@ -44,6 +44,7 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute"),
 		m_disabled(false),
+		m_execute_group(0),
 		m_vblank_interrupt_screen(nullptr),
 		m_timed_interrupt_period(attotime::zero),
 		m_nextexec(nullptr),
@@ -94,6 +95,21 @@ void device_execute_interface::static_set_disable(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_execute_group - configuration
+//  helper to let a device run in its own execute
+//  group, in parallel with the main thread
+//-------------------------------------------------
+
+void device_execute_interface::static_set_execute_group(device_t &device, int group)
+{
+	device_execute_interface *exec;
+	if (!device.interface(exec))
+		throw emu_fatalerror("MCFG_DEVICE_EXECUTE_GROUP called on device '%s' with no execute interface", device.tag());
+	exec->m_execute_group = group;
+}
+
+
 //-------------------------------------------------
 //  static_set_vblank_int - configuration helper
 //  to set up VBLANK interrupts on the device
@@ -239,6 +255,7 @@ void device_execute_interface::suspend(UINT32 reason, bool eatcycles)
 {
 if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
 	// set the suspend reason and eat cycles flag
+	device_scheduler::state_lock lock(*m_scheduler);
 	m_nextsuspend |= reason;
 	m_nexteatcycles = eatcycles;
 	suspend_resume_changed();
@@ -254,6 +271,7 @@ void device_execute_interface::resume(UINT32 reason)
 {
 if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
 	// clear the suspend reason and eat cycles flag
+	device_scheduler::state_lock lock(*m_scheduler);
 	m_nextsuspend &= ~reason;
 	suspend_resume_changed();
 }
@@ -267,6 +285,7 @@ if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
 void device_execute_interface::spin_until_time(const attotime &duration)
 {
 	static int timetrig = 0;
+	device_scheduler::state_lock lock(*m_scheduler);
 
 	// suspend until the given trigger fires
 	suspend_until_trigger(TRIGGER_SUSPENDTIME + timetrig, true);
@@ -619,7 +638,10 @@ int device_execute_interface::standard_irq_callback(int irqline)
 
 	// if there's a driver callback, run it to get the vector
 	if (!m_driver_irq.isnull())
+	{
+		device_scheduler::group_sync sync;
 		vector = m_driver_irq(device(),irqline);
+	}
 
 	// notify the debugger
 	debugger_interrupt_hook(&device(), irqline);
@@ -770,6 +792,9 @@ if (TEMPLOG) printf("setline(%s,%d,%d,%d)\n", m_execute->device().tag(), m_linen
 		return;
 	}
 
+	// the queue can be filled from any execute group
+	device_scheduler::state_lock lock(m_execute->scheduler());
+
 	// if we're full of events, flush the queue and log a message
 	int event_index = m_qindex++;
 	if (event_index >= ARRAY_LENGTH(m_queue))
@@ -55,6 +55,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSHOT_DIRECTORY,                         "snap",      OPTION_STRING,     "directory to save/load screenshots" },
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
+	{ OPTION_DRC_CACHE_DIRECTORY,                        "drc",       OPTION_STRING,     "directory to save DRC block profiles" },
+	{ OPTION_HASH_CACHE_DIRECTORY,                       "hashcache", OPTION_STRING,     "directory to save the index of ROM file hashes" },
 
 	// state/playback options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -64,6 +66,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",            OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",            OPTION_BOOLEAN,    "close the program at the end of playback" },
+	{ OPTION_REWIND,                                     "0",            OPTION_INTEGER,    "number of per-frame state snapshots to keep in memory for rewinding; 0 disables" },
+	{ OPTION_REWIND_KEYFRAME,                            "60",           OPTION_INTEGER,    "number of rewind snapshots between full keyframes; the rest only hold changed state" },
+	{ OPTION_REWIND_COMPRESS,                            "1",            OPTION_BOOLEAN,    "compress rewind snapshots in memory" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
@@ -136,6 +141,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_SOUND_PARALLEL,                             "0",         OPTION_BOOLEAN,    "generate independent sound streams in parallel" },
 
 	// input options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -189,6 +195,10 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_CACHE,                                  "0",         OPTION_BOOLEAN,    "save and reuse DRC block profiles across sessions" },
+	{ OPTION_DRC_ASYNC,                                  "0",         OPTION_BOOLEAN,    "generate DRC native code on a worker thread while interpreting" },
+	{ OPTION_MAP_ROMS,                                   "1",         OPTION_BOOLEAN,    "map ROM files that fill a whole region into memory instead of reading them" },
+	{ OPTION_HASH_CACHE,                                 "0",         OPTION_BOOLEAN,    "save and reuse ROM file hashes across sessions" },
 	{ OPTION_BIOS,                                       nullptr,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
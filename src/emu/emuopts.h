@@ -68,6 +68,8 @@ enum
 #define OPTION_SNAPSHOT_DIRECTORY   "snapshot_directory"
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
+#define OPTION_DRC_CACHE_DIRECTORY  "drc_cache_directory"
+#define OPTION_HASH_CACHE_DIRECTORY "hash_cache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
@@ -76,6 +78,9 @@ enum
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_KEYFRAME      "rewind_keyframe"
+#define OPTION_REWIND_COMPRESS      "rewind_compress"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #ifdef MAME_DEBUG
@@ -140,6 +145,7 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_SOUND_PARALLEL       "sound_parallel"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -182,6 +188,10 @@ enum
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_DRC_ASYNC            "drc_async"
+#define OPTION_MAP_ROMS             "map_roms"
+#define OPTION_HASH_CACHE           "hash_cache"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -262,6 +272,8 @@ public:
 	const char *snapshot_directory() const { return value(OPTION_SNAPSHOT_DIRECTORY); }
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
+	const char *drc_cache_directory() const { return value(OPTION_DRC_CACHE_DIRECTORY); }
+	const char *hash_cache_directory() const { return value(OPTION_HASH_CACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -270,6 +282,9 @@ public:
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
+	int rewind() const { return int_value(OPTION_REWIND); }
+	int rewind_keyframe() const { return int_value(OPTION_REWIND_KEYFRAME); }
+	bool rewind_compress() const { return bool_value(OPTION_REWIND_COMPRESS); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 #ifdef MAME_DEBUG
@@ -334,6 +349,7 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	bool sound_parallel() const { return bool_value(OPTION_SOUND_PARALLEL); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -374,6 +390,10 @@ public:
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
+	bool drc_async() const { return bool_value(OPTION_DRC_ASYNC); }
+	bool map_roms() const { return bool_value(OPTION_MAP_ROMS); }
+	bool hash_cache() const { return bool_value(OPTION_HASH_CACHE); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
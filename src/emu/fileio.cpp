@@ -11,6 +11,7 @@
 #include "emu.h"
 #include "unzip.h"
 #include "fileio.h"
+#include "coreutil.h"
 
 
 const UINT32 OPEN_FLAG_HAS_CRC  = 0x10000;
@@ -129,6 +130,247 @@ const osd_directory_entry *file_enumerator::next()
 
 
 
+//**************************************************************************
+//  FILE HASH CACHE
+//**************************************************************************
+
+// index file name and header
+static const char HASH_INDEX_NAME[] = "hashes.idx";
+static const char HASH_INDEX_MAGIC[8] = { 'M', 'A', 'M', 'E', 'H', 'A', 'S', 'H' };
+static const UINT32 HASH_INDEX_VERSION = 1;
+
+std::mutex file_hash_cache::s_mutex;
+std::unordered_map<std::string, file_hash_cache::entry> file_hash_cache::s_entries;
+std::string file_hash_cache::s_directory;
+bool file_hash_cache::s_dirty = false;
+
+
+//-------------------------------------------------
+//  load - start persisting the cache in the given
+//  directory, reading any index a previous run
+//  left behind
+//-------------------------------------------------
+
+void file_hash_cache::load(const char *directory)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_directory = directory;
+	s_dirty = false;
+
+	std::string fullpath;
+	read_index(s_entries, fullpath);
+	if (!fullpath.empty())
+		osd_printf_verbose("Loaded %d entries from hash index '%s'\n", UINT32(s_entries.size()), fullpath.c_str());
+}
+
+
+//-------------------------------------------------
+//  save - write the cache back out if it is being
+//  persisted and has changed
+//-------------------------------------------------
+
+void file_hash_cache::save()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (s_directory.empty() || !s_dirty)
+		return;
+
+	// other instances may have saved since we loaded; keep what they found too
+	std::unordered_map<std::string, entry> ondisk;
+	std::string indexpath;
+	read_index(ondisk, indexpath);
+	for (auto &cached : ondisk)
+		s_entries.insert(std::move(cached));
+
+	// drop entries for files that have gone away or changed
+	for (auto it = s_entries.begin(); it != s_entries.end(); )
+	{
+		if (it->second.used || still_valid(it->first, it->second.modified))
+			++it;
+		else
+			it = s_entries.erase(it);
+	}
+
+	// build the whole index in memory first
+	std::vector<UINT8> data(16);
+	memcpy(&data[0], HASH_INDEX_MAGIC, sizeof(HASH_INDEX_MAGIC));
+	put_le32(&data[8], HASH_INDEX_VERSION);
+	put_le32(&data[12], s_entries.size());
+	for (auto &cached : s_entries)
+	{
+		std::string const hashes = cached.second.hashes.internal_string();
+		size_t const offset = data.size();
+		data.resize(offset + 4 + cached.first.length() + 20 + hashes.length());
+		UINT8 *dest = &data[offset];
+		put_le32(dest, cached.first.length());
+		memcpy(dest + 4, cached.first.c_str(), cached.first.length());
+		dest += 4 + cached.first.length();
+		put_le64(&dest[0], cached.second.length);
+		put_le64(&dest[8], cached.second.modified);
+		put_le32(&dest[16], hashes.length());
+		memcpy(dest + 20, hashes.c_str(), hashes.length());
+	}
+
+	// write it under a name no other instance will pick, then move it over the index in one step
+	// so a crash or a concurrent save never leaves a torn index behind
+	std::string const tempname = string_format("%s.%08X%08X.tmp", HASH_INDEX_NAME, UINT32(osd_ticks()), UINT32(reinterpret_cast<FPTR>(&data[0])));
+	std::string temppath;
+	{
+		emu_file file(s_directory.c_str(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(tempname.c_str()) != osd_file::error::NONE)
+			return;
+		temppath = file.fullpath();
+		if (file.write(&data[0], data.size()) != data.size())
+		{
+			file.remove_on_close();
+			return;
+		}
+	}
+	if (indexpath.empty())
+		indexpath = temppath.substr(0, temppath.length() - tempname.length()).append(HASH_INDEX_NAME);
+	if (osd_file::rename(temppath, indexpath) != osd_file::error::NONE)
+	{
+		osd_file::remove(temppath);
+		return;
+	}
+	s_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  read_index - read the index file, if there is
+//  a valid one, into the given map; entries
+//  already there are kept
+//-------------------------------------------------
+
+void file_hash_cache::read_index(std::unordered_map<std::string, entry> &entries, std::string &fullpath)
+{
+	emu_file file(s_directory.c_str(), OPEN_FLAG_READ);
+	if (file.open(HASH_INDEX_NAME) != osd_file::error::NONE)
+		return;
+	fullpath = file.fullpath();
+
+	// read the whole index in one go
+	std::vector<UINT8> data(file.size());
+	if (data.size() < 16 || file.read(&data[0], data.size()) != data.size())
+		return;
+	if (memcmp(&data[0], HASH_INDEX_MAGIC, sizeof(HASH_INDEX_MAGIC)) != 0 || get_le32(&data[8]) != HASH_INDEX_VERSION)
+	{
+		osd_printf_verbose("Ignoring invalid hash index '%s'\n", file.fullpath());
+		return;
+	}
+
+	// each entry is the key, length, modification time and hashes
+	UINT32 const count = get_le32(&data[12]);
+	size_t offset = 16;
+	for (UINT32 index = 0; index < count; index++)
+	{
+		if (data.size() - offset < 4)
+			break;
+		UINT32 const keylength = get_le32(&data[offset]);
+		if (data.size() - offset - 4 < size_t(keylength) + 20)
+			break;
+		std::string key(reinterpret_cast<const char *>(&data[offset + 4]), keylength);
+		offset += 4 + keylength;
+
+		entry loaded;
+		loaded.length = get_le64(&data[offset]);
+		loaded.modified = get_le64(&data[offset + 8]);
+		loaded.used = false;
+		UINT32 const hashlength = get_le32(&data[offset + 16]);
+		offset += 20;
+		if (data.size() - offset < hashlength)
+			break;
+		loaded.hashes.from_internal_string(std::string(reinterpret_cast<const char *>(&data[offset]), hashlength).c_str());
+		offset += hashlength;
+		entries.insert(std::make_pair(std::move(key), std::move(loaded)));
+	}
+}
+
+
+//-------------------------------------------------
+//  still_valid - return true if the file behind a
+//  key still exists with the same modification
+//  time; archive members are keyed below their
+//  archive, so walk up until a file turns up
+//-------------------------------------------------
+
+bool file_hash_cache::still_valid(const std::string &key, INT64 modified)
+{
+	std::string path(key);
+	while (!path.empty())
+	{
+		std::unique_ptr<osd_directory_entry, void (*)(void *)> found(osd_stat(path), &osd_free);
+		if (found && found->type == ENTTYPE_FILE)
+			return found->last_modified == modified;
+		if (found && found->type == ENTTYPE_DIR)
+			return false;
+		std::string::size_type const separator = path.find_last_of(PATH_SEPARATOR[0]);
+		if (separator == std::string::npos || separator == 0)
+			return false;
+		path.resize(separator);
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  make_key - build the key for a file, or for a
+//  member of an archive file
+//-------------------------------------------------
+
+std::string file_hash_cache::make_key(const std::string &path, const char *member)
+{
+	// use absolute paths so the index is valid regardless of the working directory
+	std::string key;
+	if (osd_get_full_path(key, path) != osd_file::error::NONE)
+		key = path;
+	if (member != nullptr)
+		key.append(PATH_SEPARATOR).append(member);
+	return key;
+}
+
+
+//-------------------------------------------------
+//  find - look up the hashes previously computed
+//  for a file, provided it hasn't changed since
+//  and all the requested types are present
+//-------------------------------------------------
+
+bool file_hash_cache::find(const std::string &key, UINT64 length, INT64 modified, const char *types, hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	auto const found = s_entries.find(key);
+	if (found == s_entries.end() || found->second.length != length || found->second.modified != modified)
+		return false;
+
+	std::string const cachedtypes = found->second.hashes.hash_types();
+	for (const char *scan = types; *scan != 0; scan++)
+		if (cachedtypes.find_first_of(*scan) == std::string::npos)
+			return false;
+	found->second.used = true;
+	hashes = found->second.hashes;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add - remember the hashes computed for a file
+//-------------------------------------------------
+
+void file_hash_cache::add(const std::string &key, UINT64 length, INT64 modified, const hash_collection &hashes)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	entry &target = s_entries[key];
+	target.length = length;
+	target.modified = modified;
+	target.hashes = hashes;
+	target.used = true;
+	s_dirty = true;
+}
+
+
+
 //**************************************************************************
 //  EMU FILE
 //**************************************************************************
@@ -216,6 +458,14 @@ hash_collection &emu_file::hashes(const char *types)
 	if (needed.empty())
 		return m_hashes;
 
+	// see if an earlier open of the same unchanged file already computed them
+	std::string key;
+	UINT64 length = 0;
+	INT64 modified = 0;
+	bool const cacheable = hash_cache_key(key, length, modified);
+	if (cacheable && file_hash_cache::find(key, length, modified, needed.c_str(), m_hashes))
+		return m_hashes;
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
@@ -224,18 +474,21 @@ hash_collection &emu_file::hashes(const char *types)
 
 	// if we have ZIP data, just hash that directly
 	if (!m_zipdata.empty())
-	{
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
-		return m_hashes;
-	}
+	else
+	{
+		// read the data if we can
+		const UINT8 *filedata = (const UINT8 *)m_file->buffer();
+		if (filedata == nullptr)
+			return m_hashes;
 
-	// read the data if we can
-	const UINT8 *filedata = (const UINT8 *)m_file->buffer();
-	if (filedata == nullptr)
-		return m_hashes;
+		// compute the hash
+		m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	}
 
-	// compute the hash
-	m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	// remember what we computed for the next time
+	if (cacheable)
+		file_hash_cache::add(key, length, modified, m_hashes);
 	return m_hashes;
 }
 
@@ -352,6 +605,9 @@ osd_file::error emu_file::open_ram(const void *data, UINT32 length)
 {
 	// set a fake filename and CRC
 	m_filename = "RAM";
+	m_fullpath.clear();
+	m_archivepath.clear();
+	m_archivemember.clear();
 	m_crc = 0;
 
 	// use the core_file's built-in RAM support
@@ -379,6 +635,8 @@ void emu_file::close()
 	// reset our hashes and path as well
 	m_hashes.reset();
 	m_fullpath.clear();
+	m_archivepath.clear();
+	m_archivemember.clear();
 }
 
 
@@ -620,6 +878,45 @@ bool emu_file::part_of_mediapath(std::string path)
 	return result;
 }
 
+//-------------------------------------------------
+//  map - map the whole file into memory
+//  copy-on-write without reading it; this only
+//  works for plain read-only files and for
+//  archive members that are stored uncompressed
+//  and have not been loaded yet; release the
+//  result with osd_file::unmap
+//-------------------------------------------------
+
+osd_file::error emu_file::map(void *&base, UINT32 &length)
+{
+	std::string path;
+	UINT64 offset = 0;
+	UINT64 size;
+
+	// archive members must be stored and still unloaded (see OPEN_FLAG_NO_PRELOAD)
+	if (m_zipfile)
+	{
+		if (m_zipfile->stored_location(path, offset) != util::archive_file::error::NONE)
+			return osd_file::error::FAILURE;
+		size = m_ziplength;
+	}
+
+	// otherwise we need a file on disk that we opened read-only
+	else if (m_file && m_zipdata.empty() && !m_fullpath.empty() && (m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ)
+	{
+		path = m_fullpath;
+		size = m_file->size();
+	}
+	else
+		return osd_file::error::FAILURE;
+
+	if (size == 0 || size > 0xffffffff)
+		return osd_file::error::FAILURE;
+	length = UINT32(size);
+	return osd_file::map(path, offset, length, base);
+}
+
+
 //-------------------------------------------------
 //  attempt_zipped - attempt to open a ZIPped file
 //-------------------------------------------------
@@ -684,6 +981,8 @@ osd_file::error emu_file::attempt_zipped()
 			{
 				m_zipfile = std::move(zip);
 				m_ziplength = m_zipfile->current_uncompressed_length();
+				m_archivepath = m_fullpath + suffixes[i];
+				m_archivemember = m_zipfile->current_name();
 
 				// build a hash with just the CRC
 				m_hashes.reset();
@@ -732,3 +1031,37 @@ osd_file::error emu_file::load_zipped_file()
 	m_zipfile.reset();
 	return osd_file::error::NONE;
 }
+
+
+//-------------------------------------------------
+//  hash_cache_key - determine how the hashes of
+//  the currently open file are identified in the
+//  file hash cache; archive members are keyed by
+//  the archive's path and modification time
+//-------------------------------------------------
+
+bool emu_file::hash_cache_key(std::string &key, UINT64 &length, INT64 &modified) const
+{
+	// only files opened read-only from disk can be cached
+	if ((m_openflags & OPEN_FLAG_WRITE) || m_fullpath.empty())
+		return false;
+
+	// stat whichever file holds the data
+	std::string const &diskpath = m_archivepath.empty() ? m_fullpath : m_archivepath;
+	std::unique_ptr<osd_directory_entry, void (*)(void *)> entry(osd_stat(diskpath), &osd_free);
+	if (!entry || entry->type != ENTTYPE_FILE || entry->last_modified == 0)
+		return false;
+
+	if (m_archivepath.empty())
+	{
+		key = file_hash_cache::make_key(m_fullpath);
+		length = entry->size;
+	}
+	else
+	{
+		key = file_hash_cache::make_key(m_archivepath, m_archivemember.c_str());
+		length = m_ziplength;
+	}
+	modified = entry->last_modified;
+	return true;
+}
@@ -16,6 +16,9 @@
 #include "corefile.h"
 #include "hash.h"
 
+#include <mutex>
+#include <unordered_map>
+
 // some systems use macros for getc/putc rather than functions
 #ifdef getc
 #undef getc
@@ -75,6 +78,45 @@ private:
 
 
 
+// ======================> file_hash_cache
+
+// process-wide cache of hashes computed for files opened for reading; entries
+// are keyed by absolute path and only reused while the size and modification
+// time match, and can optionally be persisted to an index file between runs
+class file_hash_cache
+{
+public:
+	// index file management
+	static void load(const char *directory);
+	static void save();
+
+	// lookup and update
+	static std::string make_key(const std::string &path, const char *member = nullptr);
+	static bool find(const std::string &key, UINT64 length, INT64 modified, const char *types, hash_collection &hashes);
+	static void add(const std::string &key, UINT64 length, INT64 modified, const hash_collection &hashes);
+
+private:
+	struct entry
+	{
+		UINT64              length;
+		INT64               modified;
+		hash_collection     hashes;
+		bool                used;           // found or added during this run
+	};
+
+	// index file helpers
+	static void read_index(std::unordered_map<std::string, entry> &entries, std::string &fullpath);
+	static bool still_valid(const std::string &key, INT64 modified);
+
+	// internal state
+	static std::mutex                               s_mutex;
+	static std::unordered_map<std::string, entry>   s_entries;
+	static std::string                              s_directory;    // where the index lives, empty if not persisted
+	static bool                                     s_dirty;        // have entries changed since the load?
+};
+
+
+
 // ======================> emu_file
 
 class emu_file
@@ -92,6 +134,7 @@ public:
 	const char *fullpath() const { return m_fullpath.c_str(); }
 	UINT32 openflags() const { return m_openflags; }
 	hash_collection &hashes(const char *types);
+	bool hash_cache_key(std::string &key, UINT64 &length, INT64 &modified) const;
 	bool restrict_to_mediapath() { return m_restrict_to_mediapath; }
 	bool part_of_mediapath(std::string path);
 
@@ -140,6 +183,9 @@ public:
 	// buffers
 	void flush();
 
+	// memory mapping
+	osd_file::error map(void *&base, UINT32 &length);
+
 private:
 	bool compressed_file_ready(void);
 
@@ -150,6 +196,8 @@ private:
 	// internal state
 	std::string     m_filename;                     // original filename provided
 	std::string     m_fullpath;                     // full filename
+	std::string     m_archivepath;                  // path of the archive we opened from, if any
+	std::string     m_archivemember;                // name of the file within that archive
 	util::core_file::ptr m_file;                    // core file pointer
 	path_iterator   m_iterator;                     // iterator for paths
 	path_iterator   m_mediapaths;                   // media-path iterator
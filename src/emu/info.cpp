@@ -178,9 +178,11 @@ const char info_xml_creator::s_dtd_string[] =
 //-------------------------------------------------
 
 info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
-	: m_output(nullptr),
-		m_drivlist(drivlist),
-		m_lookup_options(m_drivlist.options())
+	: m_drivlist(drivlist),
+		m_lookup_options(m_drivlist.options()),
+		m_parallel(false),
+		m_compact(false),
+		m_shard_devices(nullptr)
 {
 	m_lookup_options.remove_device_options();
 }
@@ -193,18 +195,51 @@ info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
 
 void info_xml_creator::output(FILE *out, bool nodevices)
 {
-	m_output = out;
+	output_header(out);
 
-	// output the DTD
-	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
-	std::string dtd(s_dtd_string);
-	strreplace(dtd, "__XML_ROOT__", XML_ROOT);
-	strreplace(dtd, "__XML_TOP__", XML_TOP);
+	// describe the drivers across the worker threads if asked to
+	if (m_parallel)
+		output_parallel(out, nodevices);
+	else
+	{
+		// iterate through the drivers, outputting one at a time
+		while (m_drivlist.next())
+		{
+			output_one();
+			flush_output(out);
+		}
 
-	fprintf(m_output, "%s\n\n", dtd.c_str());
+		// output devices (both devices with roms and slot devices)
+		if (!nodevices)
+			output_devices(out);
+	}
+
+	// close the top level tag
+	util::stream_format(m_output, "</%s>\n",XML_ROOT);
+	flush_output(out);
+}
+
+
+//-------------------------------------------------
+//  output_header - print the XML declaration,
+//  the DTD and the top-level tag
+//-------------------------------------------------
+
+void info_xml_creator::output_header(FILE *out)
+{
+	// output the DTD, unless we're being compact
+	util::stream_format(m_output, "<?xml version=\"1.0\"?>\n");
+	if (!m_compact)
+	{
+		std::string dtd(s_dtd_string);
+		strreplace(dtd, "__XML_ROOT__", XML_ROOT);
+		strreplace(dtd, "__XML_TOP__", XML_TOP);
+
+		util::stream_format(m_output, "%s\n\n", dtd.c_str());
+	}
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	util::stream_format(m_output, "<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 		"yes"
 #else
@@ -215,17 +250,129 @@ void info_xml_creator::output(FILE *out, bool nodevices)
 		xml_normalize_string(build_version),
 		CONFIG_VERSION
 	);
+	flush_output(out);
+}
+
 
-	// iterate through the drivers, outputting one at a time
+//-------------------------------------------------
+//  output_parallel - describe the drivers in
+//  shards across the worker threads, writing
+//  each shard out in order as it completes
+//-------------------------------------------------
+
+void info_xml_creator::output_parallel(FILE *out, bool nodevices)
+{
+	// gather the drivers we're describing
+	std::vector<int> drivers;
 	while (m_drivlist.next())
-		output_one();
+		drivers.push_back(m_drivlist.current());
 
-	// output devices (both devices with roms and slot devices)
-	if (!nodevices)
-		output_devices();
+	// split them into shards
+	std::vector<info_shard> shards;
+	for (int start = 0; start < int(drivers.size()); start += INFO_SHARD_SIZE)
+		shards.push_back({ &m_drivlist, &drivers, start, MIN(start + INFO_SHARD_SIZE, int(drivers.size())), nodevices, std::string(), { }, nullptr });
 
-	// close the top level tag
-	fprintf(m_output, "</%s>\n",XML_ROOT);
+	// queue everything, falling back to doing the work here
+	osd_work_queue *queue = (shards.size() > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	for (info_shard &shard : shards)
+	{
+		shard.item = (queue != nullptr) ? osd_work_item_queue(queue, output_shard, &shard, 0) : nullptr;
+		if (shard.item == nullptr)
+			output_shard(&shard, 0);
+	}
+
+	// write the machines out in driver order, holding on to devices seen for the first time
+	std::unordered_set<std::string> shortnames;
+	std::string devices;
+	for (info_shard &shard : shards)
+	{
+		if (shard.item != nullptr)
+		{
+			while (!osd_work_item_wait(shard.item, 100 * osd_ticks_per_second())) { }
+			osd_work_item_release(shard.item);
+			shard.item = nullptr;
+		}
+		write_text(out, shard.machines);
+		for (auto &device : shard.devices)
+			if (shortnames.insert(device.first).second)
+				devices.append(device.second);
+
+		// free up the memory as we go
+		std::string().swap(shard.machines);
+		std::vector<std::pair<std::string, std::string>>().swap(shard.devices);
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+
+	// devices follow all the machines, as they do when describing serially
+	write_text(out, devices);
+}
+
+
+//-------------------------------------------------
+//  output_shard - describe one shard of drivers
+//  on a worker thread
+//-------------------------------------------------
+
+void *info_xml_creator::output_shard(void *param, int threadid)
+{
+	info_shard &shard = *reinterpret_cast<info_shard *>(param);
+
+	// build an enumerator covering just our drivers
+	driver_enumerator drivlist(shard.drivlist->options());
+	drivlist.exclude_all();
+	for (int index = shard.start; index < shard.end; index++)
+		drivlist.include((*shard.drivers)[index]);
+
+	// describe each driver followed by its devices; devices are only checked
+	// against the ones earlier in this shard, and the merge weeds out the rest
+	info_xml_creator creator(drivlist);
+	creator.m_shard_devices = &shard.devices;
+	std::unordered_set<std::string> shortnames;
+	while (drivlist.next())
+	{
+		creator.output_one();
+		shard.machines.append(creator.m_output.str());
+		creator.m_output.str("");
+		if (!shard.nodevices)
+			creator.output_current_devices(shortnames);
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  flush_output - write out everything gathered
+//  so far and start afresh
+//-------------------------------------------------
+
+void info_xml_creator::flush_output(FILE *out)
+{
+	write_text(out, m_output.str());
+	m_output.str("");
+}
+
+
+//-------------------------------------------------
+//  write_text - write a block of XML, stripping
+//  the indentation in compact mode
+//-------------------------------------------------
+
+void info_xml_creator::write_text(FILE *out, const std::string &text)
+{
+	if (!m_compact)
+	{
+		fwrite(text.c_str(), 1, text.length(), out);
+		return;
+	}
+
+	for (std::string::size_type pos = text.find_first_not_of('\t'); pos != std::string::npos; pos = text.find_first_not_of('\t', pos))
+	{
+		std::string::size_type end = text.find('\n', pos);
+		end = (end == std::string::npos) ? text.length() : end + 1;
+		fwrite(text.c_str() + pos, 1, end - pos, out);
+		pos = end;
+	}
 }
 
 
@@ -250,8 +397,8 @@ void info_xml_creator::output_one()
 		portlist.append(*device, errors);
 
 	// print the header and the game name
-	fprintf(m_output, "\t<%s",XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
+	util::stream_format(m_output, "\t<%s",XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.source_file, '/');
@@ -259,38 +406,38 @@ void info_xml_creator::output_one()
 		start = strrchr(driver.source_file, '\\');
 	if (start == nullptr)
 		start = driver.source_file - 1;
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
+	util::stream_format(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
 
 	// append bios and runnable flags
 	if (driver.flags & MACHINE_IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		util::stream_format(m_output, " isbios=\"yes\"");
 	if (driver.flags & MACHINE_NO_STANDALONE)
-		fprintf(m_output, " runnable=\"no\"");
+		util::stream_format(m_output, " runnable=\"no\"");
 	if (driver.flags & MACHINE_MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		util::stream_format(m_output, " ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = m_drivlist.find(driver.parent);
 	if (clone_of != -1 && !(m_drivlist.driver(clone_of).flags & MACHINE_IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		util::stream_format(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		util::stream_format(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
 
 	// display sample information and close the game tag
 	output_sampleof();
-	fprintf(m_output, ">\n");
+	util::stream_format(m_output, ">\n");
 
 	// output game description
 	if (driver.description != nullptr)
-		fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
+		util::stream_format(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != nullptr && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
+		util::stream_format(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != nullptr)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
+		util::stream_format(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
 
 	// now print various additional information
 	output_bios();
@@ -312,7 +459,7 @@ void info_xml_creator::output_one()
 	output_ramoptions();
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n",XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n",XML_TOP);
 }
 
 
@@ -344,16 +491,16 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s", XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
+	util::stream_format(m_output, "\t<%s", XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
 	std::string src(device.source());
 	strreplace(src,"../", "");
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(src.c_str()));
-	fprintf(m_output, " isdevice=\"yes\"");
-	fprintf(m_output, " runnable=\"no\"");
+	util::stream_format(m_output, " sourcefile=\"%s\"", xml_normalize_string(src.c_str()));
+	util::stream_format(m_output, " isdevice=\"yes\"");
+	util::stream_format(m_output, " runnable=\"no\"");
 	output_sampleof();
-	fprintf(m_output, ">\n");
-	fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
+	util::stream_format(m_output, ">\n");
+	util::stream_format(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
 
 	output_rom(device);
 
@@ -371,7 +518,7 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 	output_adjusters(portlist);
 	output_images(device, devtag);
 	output_slots(device, devtag);
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n", XML_TOP);
 }
 
 
@@ -387,57 +534,83 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 //  directly to a driver as device or sub-device)
 //-------------------------------------------------
 
-void info_xml_creator::output_devices()
+void info_xml_creator::output_devices(FILE *out)
 {
 	m_drivlist.reset();
 	std::unordered_set<std::string> shortnames;
 
 	while (m_drivlist.next())
 	{
-		// first, run through devices with roms which belongs to the default configuration
-		device_iterator deviter(m_drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
+		output_current_devices(shortnames);
+		flush_output(out);
+	}
+}
+
+
+//-------------------------------------------------
+//  output_current_devices - print the XML info
+//  for devices used by the current driver that
+//  haven't been seen yet
+//-------------------------------------------------
+
+void info_xml_creator::output_current_devices(std::unordered_set<std::string> &shortnames)
+{
+	// first, run through devices with roms which belongs to the default configuration
+	device_iterator deviter(m_drivlist.config().root_device());
+	for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
+	{
+		if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
+			output_new_device(shortnames, *device, device->tag());
+	}
+
+	// then, run through slot devices
+	slot_interface_iterator iter(m_drivlist.config().root_device());
+	for (const device_slot_interface *slot = iter.first(); slot != nullptr; slot = iter.next())
+	{
+		for (const device_slot_option &option : slot->option_list())
 		{
-			if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
+			std::string temptag("_");
+			temptag.append(option.name());
+			device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option.devtype(), 0);
+
+			// notify this device and all its subdevices that they are now configured
+			device_iterator subiter(*dev);
+			for (device_t *device = subiter.first(); device != nullptr; device = subiter.next())
+				if (!device->configured())
+					device->config_complete();
+
+			output_new_device(shortnames, *dev, temptag.c_str());
+
+			// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
+			device_iterator deviter2(*dev);
+			for (device_t *device = deviter2.first(); device != nullptr; device = deviter2.next())
 			{
-				if (shortnames.insert(device->shortname()).second)
-					output_one_device(*device, device->tag());
+				if (device->owner() == dev && device->shortname()!= nullptr && device->shortname()[0]!='\0')
+					output_new_device(shortnames, *device, device->tag());
 			}
+
+			const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
 		}
+	}
+}
 
-		// then, run through slot devices
-		slot_interface_iterator iter(m_drivlist.config().root_device());
-		for (const device_slot_interface *slot = iter.first(); slot != nullptr; slot = iter.next())
-		{
-			for (const device_slot_option &option : slot->option_list())
-			{
-				std::string temptag("_");
-				temptag.append(option.name());
-				device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option.devtype(), 0);
-
-				// notify this device and all its subdevices that they are now configured
-				device_iterator subiter(*dev);
-				for (device_t *device = subiter.first(); device != nullptr; device = subiter.next())
-					if (!device->configured())
-						device->config_complete();
-
-				if (shortnames.insert(dev->shortname()).second)
-					output_one_device(*dev, temptag.c_str());
-
-				// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
-				device_iterator deviter2(*dev);
-				for (device_t *device = deviter2.first(); device != nullptr; device = deviter2.next())
-				{
-					if (device->owner() == dev && device->shortname()!= nullptr && device->shortname()[0]!='\0')
-					{
-						if (shortnames.insert(device->shortname()).second)
-							output_one_device(*device, device->tag());
-					}
-				}
 
-				const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
-			}
-		}
+//-------------------------------------------------
+//  output_new_device - print the XML info for a
+//  device if its short name hasn't been seen;
+//  shards keep each one apart for the merge
+//-------------------------------------------------
+
+void info_xml_creator::output_new_device(std::unordered_set<std::string> &shortnames, device_t &device, const char *devtag)
+{
+	if (!shortnames.insert(device.shortname()).second)
+		return;
+
+	output_one_device(device, devtag);
+	if (m_shard_devices != nullptr)
+	{
+		m_shard_devices->emplace_back(device.shortname(), m_output.str());
+		m_output.str("");
 	}
 }
 
@@ -452,7 +625,7 @@ void info_xml_creator::output_device_roms()
 	device_iterator deviter(m_drivlist.config().root_device());
 	for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
 		if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device->shortname()));
+			util::stream_format(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device->shortname()));
 }
 
 
@@ -470,7 +643,7 @@ void info_xml_creator::output_sampleof()
 		samples_iterator sampiter(*device);
 		if (sampiter.altbasename() != nullptr)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
+			util::stream_format(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -495,12 +668,12 @@ void info_xml_creator::output_bios()
 		if (ROMENTRY_ISSYSTEM_BIOS(rom))
 		{
 			// output extracted name and descriptions
-			fprintf(m_output, "\t\t<biosset");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
-			fprintf(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
+			util::stream_format(m_output, "\t\t<biosset");
+			util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
+			util::stream_format(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
 			if (ROM_GETBIOSFLAGS(rom) == 1)
-				fprintf(m_output, " default=\"yes\"");
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " default=\"yes\"");
+			util::stream_format(m_output, "/>\n");
 		}
 }
 
@@ -601,7 +774,7 @@ void info_xml_creator::output_rom(device_t &device)
 
 				output << "/>\n";
 
-				fprintf(m_output, "%s", output.str().c_str());
+				util::stream_format(m_output, "%s", output.str().c_str());
 			}
 		}
 }
@@ -627,7 +800,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
+			util::stream_format(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
 		}
 	}
 }
@@ -649,12 +822,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(exec->device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(exec->device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec->device().clock());
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"cpu\"");
+			util::stream_format(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(exec->device().name()));
+			util::stream_format(m_output, " clock=\"%d\"", exec->device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 
@@ -667,13 +840,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(sound->device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(sound->device().name()));
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"audio\"");
+			util::stream_format(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(sound->device().name()));
 			if (sound->device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound->device().clock());
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " clock=\"%d\"", sound->device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 }
@@ -695,43 +868,43 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			std::string newtag(screendev->tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<display");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<display");
+			util::stream_format(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
 
 			switch (screendev->screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    util::stream_format(m_output, " type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    util::stream_format(m_output, " type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       util::stream_format(m_output, " type=\"lcd\"");     break;
+				default:                    util::stream_format(m_output, " type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (m_drivlist.driver().flags & ORIENTATION_MASK)
 			{
 				case ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"0\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"180\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\"");
+					util::stream_format(m_output, " rotate=\"180\"");
 					break;
 				case ORIENTATION_SWAP_XY:
-					fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"90\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"90\"");
+					util::stream_format(m_output, " rotate=\"90\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\"");
+					util::stream_format(m_output, " rotate=\"270\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"270\" flipx=\"yes\"");
 					break;
 				default:
-					fprintf(m_output, " rotate=\"0\"");
+					util::stream_format(m_output, " rotate=\"0\"");
 					break;
 			}
 
@@ -739,12 +912,12 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			if (screendev->screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev->visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				util::stream_format(m_output, " width=\"%d\"", visarea.width());
+				util::stream_format(m_output, " height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
+			util::stream_format(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -752,15 +925,15 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			{
 				int pixclock = screendev->width() * screendev->height() * ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev->width());
-				fprintf(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev->height());
-				fprintf(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
+				util::stream_format(m_output, " pixclock=\"%d\"", pixclock);
+				util::stream_format(m_output, " htotal=\"%d\"", screendev->width());
+				util::stream_format(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
+				util::stream_format(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
+				util::stream_format(m_output, " vtotal=\"%d\"", screendev->height());
+				util::stream_format(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
+				util::stream_format(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			util::stream_format(m_output, " />\n");
 		}
 	}
 }
@@ -781,7 +954,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == nullptr)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	util::stream_format(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -990,17 +1163,17 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 		}
 
 	// output the basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	util::stream_format(m_output, "\t\t<input");
+	util::stream_format(m_output, " players=\"%d\"", nplayer);
 	if (nbutton != 0)
-		fprintf(m_output, " buttons=\"%d\"", nbutton);
+		util::stream_format(m_output, " buttons=\"%d\"", nbutton);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		util::stream_format(m_output, " coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		util::stream_format(m_output, " service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		util::stream_format(m_output, " tilt=\"yes\"");
+	util::stream_format(m_output, ">\n");
 
 	// output the joystick types
 	if (joytype[1]==0 && joytype[2]!=0) { joytype[1] = joytype[2]; joytype[2] = 0; }
@@ -1009,7 +1182,7 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 	if (joytype[0] != 0)
 	{
 		const char *joys = (joytype[2]!=0) ? "triple" : (joytype[1]!=0) ? "double" : "";
-		fprintf(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
+		util::stream_format(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
 		for (int lp=0; lp<3 && joytype[lp]!=0; lp++)
 		{
 			const char *plural = (lp==2) ? "3" : (lp==1) ? "2" : "";
@@ -1041,46 +1214,46 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 					ways = "strange2";
 					break;
 			}
-			fprintf(m_output, " ways%s=\"%s\"", plural,ways);
+			util::stream_format(m_output, " ways%s=\"%s\"", plural,ways);
 		}
-		fprintf(m_output, "/>\n");
+		util::stream_format(m_output, "/>\n");
 	}
 
 	// output analog types
 	for (auto & elem : control_info)
 		if (elem.type != nullptr)
 		{
-			fprintf(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(elem.type));
+			util::stream_format(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(elem.type));
 			if (elem.min != 0 || elem.max != 0)
 			{
-				fprintf(m_output, " minimum=\"%d\"", elem.min);
-				fprintf(m_output, " maximum=\"%d\"", elem.max);
+				util::stream_format(m_output, " minimum=\"%d\"", elem.min);
+				util::stream_format(m_output, " maximum=\"%d\"", elem.max);
 			}
 			if (elem.sensitivity != 0)
-				fprintf(m_output, " sensitivity=\"%d\"", elem.sensitivity);
+				util::stream_format(m_output, " sensitivity=\"%d\"", elem.sensitivity);
 			if (elem.keydelta != 0)
-				fprintf(m_output, " keydelta=\"%d\"", elem.keydelta);
+				util::stream_format(m_output, " keydelta=\"%d\"", elem.keydelta);
 			if (elem.reverse)
-				fprintf(m_output, " reverse=\"yes\"");
+				util::stream_format(m_output, " reverse=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "/>\n");
 		}
 
 	// output keypad and keyboard
 	if (keypad)
-		fprintf(m_output, "\t\t\t<control type=\"keypad\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"keypad\"/>\n");
 	if (keyboard)
-		fprintf(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
 
 	// misc
 	if (mahjong)
-		fprintf(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
 	if (hanafuda)
-		fprintf(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
 	if (gambling)
-		fprintf(m_output, "\t\t\t<control type=\"gambling\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"gambling\"/>\n");
 
-	fprintf(m_output, "\t\t</input>\n");
+	util::stream_format(m_output, "\t\t</input>\n");
 }
 
 
@@ -1115,7 +1288,7 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				// terminate the switch entry
 				util::stream_format(output,"\t\t</%s>\n", outertag);
 
-				fprintf(m_output, "%s", output.str().c_str());
+				util::stream_format(m_output, "%s", output.str().c_str());
 			}
 }
 
@@ -1128,14 +1301,14 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (ioport_port &port : portlist)
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n", xml_normalize_string(port.tag()));
+		util::stream_format(m_output, "\t\t<port tag=\"%s\">\n", xml_normalize_string(port.tag()));
 		for (ioport_field &field : port.fields())
 		{
 			if(field.is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n", field.mask());
+				util::stream_format(m_output, "\t\t\t<analog mask=\"%u\"/>\n", field.mask());
 		}
 		// close element
-		fprintf(m_output,"\t\t</port>\n");
+		util::stream_format(m_output, "\t\t</port>\n");
 	}
 
 }
@@ -1151,7 +1324,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 	for (ioport_port &port : portlist)
 		for (ioport_field &field : port.fields())
 			if (field.type() == IPT_ADJUSTER)
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field.name()), field.defvalue());
+				util::stream_format(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field.name()), field.defvalue());
 }
 
 
@@ -1161,7 +1334,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver()
 {
-	fprintf(m_output, "\t\t<driver");
+	util::stream_format(m_output, "\t\t<driver");
 
 	/* The status entry is an hint for frontend authors */
 	/* to select working and not working games without */
@@ -1172,48 +1345,48 @@ void info_xml_creator::output_driver()
 	/* don't work or have major emulation problems. */
 
 	if (m_drivlist.driver().flags & (MACHINE_NOT_WORKING | MACHINE_UNEMULATED_PROTECTION | MACHINE_NO_SOUND | MACHINE_WRONG_COLORS | MACHINE_MECHANICAL))
-		fprintf(m_output, " status=\"preliminary\"");
+		util::stream_format(m_output, " status=\"preliminary\"");
 	else if (m_drivlist.driver().flags & (MACHINE_IMPERFECT_COLORS | MACHINE_IMPERFECT_SOUND | MACHINE_IMPERFECT_GRAPHICS))
-		fprintf(m_output, " status=\"imperfect\"");
+		util::stream_format(m_output, " status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		util::stream_format(m_output, " status=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		util::stream_format(m_output, " emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		util::stream_format(m_output, " emulation=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_WRONG_COLORS)
-		fprintf(m_output, " color=\"preliminary\"");
+		util::stream_format(m_output, " color=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_COLORS)
-		fprintf(m_output, " color=\"imperfect\"");
+		util::stream_format(m_output, " color=\"imperfect\"");
 	else
-		fprintf(m_output, " color=\"good\"");
+		util::stream_format(m_output, " color=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_SOUND)
-		fprintf(m_output, " sound=\"preliminary\"");
+		util::stream_format(m_output, " sound=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_SOUND)
-		fprintf(m_output, " sound=\"imperfect\"");
+		util::stream_format(m_output, " sound=\"imperfect\"");
 	else
-		fprintf(m_output, " sound=\"good\"");
+		util::stream_format(m_output, " sound=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_IMPERFECT_GRAPHICS)
-		fprintf(m_output, " graphic=\"imperfect\"");
+		util::stream_format(m_output, " graphic=\"imperfect\"");
 	else
-		fprintf(m_output, " graphic=\"good\"");
+		util::stream_format(m_output, " graphic=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		util::stream_format(m_output, " cocktail=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_UNEMULATED_PROTECTION)
-		fprintf(m_output, " protection=\"preliminary\"");
+		util::stream_format(m_output, " protection=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		util::stream_format(m_output, " savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		util::stream_format(m_output, " savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	util::stream_format(m_output, "/>\n");
 }
 
 
@@ -1233,42 +1406,42 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev->image_type_name()));
+			util::stream_format(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev->image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev->device().tag())
-				fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+				util::stream_format(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
 
 			// is this device mandatory?
 			if (imagedev->must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				util::stream_format(m_output, " mandatory=\"1\"");
 
 			if (imagedev->image_interface() && imagedev->image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", xml_normalize_string(imagedev->image_interface()));
+				util::stream_format(m_output, " interface=\"%s\"", xml_normalize_string(imagedev->image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			util::stream_format(m_output, ">\n");
 
 			const char *name = imagedev->instance_name();
 			const char *shortname = imagedev->brief_instance_name();
 
-			fprintf(m_output, "\t\t\t<instance");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(name));
-			fprintf(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "\t\t\t<instance");
+			util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(name));
+			util::stream_format(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
+			util::stream_format(m_output, "/>\n");
 
 			std::string extensions(imagedev->file_extensions());
 
 			char *ext = strtok((char *)extensions.c_str(), ",");
 			while (ext != nullptr)
 			{
-				fprintf(m_output, "\t\t\t<extension");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(ext));
-				fprintf(m_output, "/>\n");
+				util::stream_format(m_output, "\t\t\t<extension");
+				util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(ext));
+				util::stream_format(m_output, "/>\n");
 				ext = strtok(nullptr, ",");
 			}
 
-			fprintf(m_output, "\t\t</device>\n");
+			util::stream_format(m_output, "\t\t</device>\n");
 		}
 	}
 }
@@ -1291,11 +1464,11 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag.c_str()));
 
 			/*
 			 if (slot->slot_interface()[0])
-			 fprintf(m_output, " interface=\"%s\"", xml_normalize_string(slot->slot_interface()));
+			 util::stream_format(m_output, " interface=\"%s\"", xml_normalize_string(slot->slot_interface()));
 			 */
 
 			for (const device_slot_option &option : slot->option_list())
@@ -1306,17 +1479,17 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 					if (!dev->configured())
 						dev->config_complete();
 
-					fprintf(m_output, "\t\t\t<slotoption");
-					fprintf(m_output, " name=\"%s\"", xml_normalize_string(option.name()));
-					fprintf(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
+					util::stream_format(m_output, "\t\t\t<slotoption");
+					util::stream_format(m_output, " name=\"%s\"", xml_normalize_string(option.name()));
+					util::stream_format(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
 					if (slot->default_option() != nullptr && strcmp(slot->default_option(),option.name())==0)
-						fprintf(m_output, " default=\"yes\"");
-					fprintf(m_output, "/>\n");
+						util::stream_format(m_output, " default=\"yes\"");
+					util::stream_format(m_output, "/>\n");
 					const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), "dummy");
 				}
 			}
 
-			fprintf(m_output, "\t\t</slot>\n");
+			util::stream_format(m_output, "\t\t</slot>\n");
 		}
 	}
 }
@@ -1332,12 +1505,12 @@ void info_xml_creator::output_software_list()
 	software_list_device_iterator iter(m_drivlist.config().root_device());
 	for (const software_list_device *swlist = iter.first(); swlist != nullptr; swlist = iter.next())
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
-		fprintf(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		util::stream_format(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
+		util::stream_format(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist->filter()) {
-			fprintf(m_output, "filter=\"%s\" ", swlist->filter());
+			util::stream_format(m_output, "filter=\"%s\" ", swlist->filter());
 		}
-		fprintf(m_output, "/>\n");
+		util::stream_format(m_output, "/>\n");
 	}
 }
 
@@ -1353,7 +1526,7 @@ void info_xml_creator::output_ramoptions()
 	ram_device_iterator iter(m_drivlist.config().root_device());
 	for (const ram_device *ram = iter.first(); ram != nullptr; ram = iter.next())
 	{
-		fprintf(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
+		util::stream_format(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
 
 		if (ram->extra_options() != nullptr)
 		{
@@ -1362,7 +1535,7 @@ void info_xml_creator::output_ramoptions()
 			{
 				std::string option;
 				option.assign(options.substr(start, (end == -1) ? -1 : end - start));
-				fprintf(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
+				util::stream_format(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
 				if (end == -1)
 					break;
 			}
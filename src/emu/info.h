@@ -13,6 +13,9 @@
 #ifndef __INFO_H__
 #define __INFO_H__
 
+#include <sstream>
+#include <unordered_set>
+
 #include "drivenum.h"
 
 
@@ -30,7 +33,34 @@ public:
 	// output
 	void output(FILE *out, bool nodevices = false);
 
+	// setters
+	void set_parallel(bool parallel) { m_parallel = parallel; }
+	void set_compact(bool compact) { m_compact = compact; }
+
 private:
+	// number of drivers described by each parallel shard
+	static const int INFO_SHARD_SIZE = 32;
+
+	// a run of drivers described on a worker thread
+	struct info_shard
+	{
+		driver_enumerator *     drivlist;           // enumerator whose options we share
+		const std::vector<int> *drivers;            // full list of driver indexes
+		int                     start;              // first driver in our run
+		int                     end;                // one past the last driver in our run
+		bool                    nodevices;          // skip device descriptions?
+		std::string             machines;           // machine descriptions, in driver order
+		std::vector<std::pair<std::string, std::string>> devices; // new devices and their descriptions, in first-seen order
+		osd_work_item *         item;               // work item describing us
+	};
+
+	// output helpers
+	void output_header(FILE *out);
+	void output_parallel(FILE *out, bool nodevices);
+	static void *output_shard(void *param, int threadid);
+	void flush_output(FILE *out);
+	void write_text(FILE *out, const std::string &text);
+
 	// internal helper
 	void output_one();
 	void output_sampleof();
@@ -52,14 +82,19 @@ private:
 	void output_ramoptions();
 
 	void output_one_device(device_t &device, const char *devtag);
-	void output_devices();
+	void output_devices(FILE *out);
+	void output_current_devices(std::unordered_set<std::string> &shortnames);
+	void output_new_device(std::unordered_set<std::string> &shortnames, device_t &device, const char *devtag);
 
 	const char *get_merge_name(const hash_collection &romhashes);
 
 	// internal state
-	FILE *                  m_output;
+	std::ostringstream      m_output;
 	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
+	bool                    m_parallel;
+	bool                    m_compact;
+	std::vector<std::pair<std::string, std::string>> *m_shard_devices;
 
 	static const char s_dtd_string[];
 };
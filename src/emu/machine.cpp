@@ -390,6 +390,10 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// capture a rewind snapshot if a frame has completed
+			if (m_save.rewind() != nullptr)
+				m_save.update_rewind();
+
 			g_profiler.stop();
 		}
 
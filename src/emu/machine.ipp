@@ -59,6 +59,9 @@ inline void running_machine::logerror(Format &&fmt, Params &&... args) const
 	{
 		g_profiler.start(PROFILER_LOGERROR);
 
+		// the buffer is shared by every execute group
+		device_scheduler::state_lock lock(m_scheduler);
+
 		// dump to the buffer
 		m_string_buffer.clear();
 		m_string_buffer.seekp(0);
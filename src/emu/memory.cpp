@@ -1027,8 +1027,8 @@ public:
 	virtual address_table_setoffset &setoffset() override { return m_setoffset; }
 
 	// watchpoint control
-	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
-	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); tlb_flush(); }
+	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); tlb_flush(); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -1089,14 +1089,19 @@ public:
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
 
-		// either read directly from RAM, or call the delegate
+		// either read directly from RAM, or call the delegate; a delegate may reach
+		// another execute group's devices, so that waits for the main thread
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
 		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
-		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
-		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
-		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
-		else if (sizeof(_NativeType) == 8) result = handler.read64(*this, offset >> 3, mask);
+		else
+		{
+			device_scheduler::group_sync sync;
+			if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
+			else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
+			else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, mask);
+			else if (sizeof(_NativeType) == 8) result = handler.read64(*this, offset >> 3, mask);
+		}
 
 		g_profiler.stop();
 		return result;
@@ -1114,14 +1119,19 @@ public:
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
 
-		// either read directly from RAM, or call the delegate
+		// either read directly from RAM, or call the delegate; a delegate may reach
+		// another execute group's devices, so that waits for the main thread
 		offset = handler.byteoffset(byteaddress);
 		_NativeType result;
 		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
-		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, 0xff);
-		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
-		else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, 0xffffffff);
-		else if (sizeof(_NativeType) == 8) result = handler.read64(*this, offset >> 3, U64(0xffffffffffffffff));
+		else
+		{
+			device_scheduler::group_sync sync;
+			if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, 0xff);
+			else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
+			else if (sizeof(_NativeType) == 4) result = handler.read32(*this, offset >> 2, 0xffffffff);
+			else if (sizeof(_NativeType) == 8) result = handler.read64(*this, offset >> 3, U64(0xffffffffffffffff));
+		}
 
 		g_profiler.stop();
 		return result;
@@ -1137,17 +1147,22 @@ public:
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
 
-		// either write directly to RAM, or call the delegate
+		// either write directly to RAM, or call the delegate; a delegate may reach
+		// another execute group's devices, so that waits for the main thread
 		offset = handler.byteoffset(byteaddress);
 		if (entry <= STATIC_BANKMAX)
 		{
 			_NativeType *dest = reinterpret_cast<_NativeType *>(handler.ramptr(offset));
 			*dest = (*dest & ~mask) | (data & mask);
 		}
-		else if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, mask);
-		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, mask);
-		else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, mask);
-		else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, data, mask);
+		else
+		{
+			device_scheduler::group_sync sync;
+			if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, mask);
+			else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, mask);
+			else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, mask);
+			else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, data, mask);
+		}
 
 		g_profiler.stop();
 	}
@@ -1162,13 +1177,18 @@ public:
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
 
-		// either write directly to RAM, or call the delegate
+		// either write directly to RAM, or call the delegate; a delegate may reach
+		// another execute group's devices, so that waits for the main thread
 		offset = handler.byteoffset(byteaddress);
 		if (entry <= STATIC_BANKMAX) *reinterpret_cast<_NativeType *>(handler.ramptr(offset)) = data;
-		else if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, 0xff);
-		else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
-		else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
-		else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, data, U64(0xffffffffffffffff));
+		else
+		{
+			device_scheduler::group_sync sync;
+			if (sizeof(_NativeType) == 1) handler.write8(*this, offset, data, 0xff);
+			else if (sizeof(_NativeType) == 2) handler.write16(*this, offset >> 1, data, 0xffff);
+			else if (sizeof(_NativeType) == 4) handler.write32(*this, offset >> 2, data, 0xffffffff);
+			else if (sizeof(_NativeType) == 8) handler.write64(*this, offset >> 3, data, U64(0xffffffffffffffff));
+		}
 
 		g_profiler.stop();
 	}
@@ -1723,8 +1743,13 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_addrchars((m_config.m_addrbus_width + 3) / 4),
 		m_logaddrchars((m_config.m_logaddr_width + 3) / 4),
 		m_manager(manager),
-		m_machine(memory.device().machine())
+		m_machine(memory.device().machine()),
+		m_tlb_maxbytes(m_config.data_width() / 8),
+		m_tlb_xor((m_config.endianness() == ENDIANNESS_NATIVE) ? 0 : (m_config.data_width() / 8 - 1))
 {
+	// start with an empty TLB
+	tlb_flush();
+
 	// notify the device
 	memory.set_address_space(spacenum, *this);
 }
@@ -2214,6 +2239,52 @@ const char *address_space::get_handler_string(read_or_write readorwrite, offs_t
 }
 
 
+//-------------------------------------------------
+//  tlb_flush - invalidate every cached page in
+//  both the read and write TLBs
+//-------------------------------------------------
+
+void address_space::tlb_flush()
+{
+	for (int index = 0; index < TLB_ENTRIES; index++)
+	{
+		m_tlb_read[index].m_tag = m_tlb_write[index].m_tag = TLB_INVALID;
+		m_tlb_read[index].m_base = m_tlb_write[index].m_base = nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  tlb_fill - load a TLB entry for the given page;
+//  pages that are not entirely backed by a single
+//  RAM/ROM/bank range are cached with a null base
+//  so that they go straight to the handlers
+//-------------------------------------------------
+
+void address_space::tlb_fill(tlb_entry &entry, offs_t pagestart, read_or_write readorwrite)
+{
+	entry.m_tag = pagestart;
+	entry.m_base = nullptr;
+
+	// watchpoints must see every access, and tiny spaces can't hold a full page
+	address_table &table = (readorwrite == ROW_WRITE) ? static_cast<address_table &>(write()) : static_cast<address_table &>(read());
+	offs_t pageend = pagestart | TLB_PAGE_MASK;
+	if (table.watchpoints_enabled() || pageend > m_bytemask)
+		return;
+
+	// the whole page must belong to one contiguous bank range
+	offs_t bytestart, byteend;
+	UINT16 entrynum = table.derive_range(pagestart, bytestart, byteend);
+	if (entrynum < STATIC_BANK1 || entrynum > STATIC_BANKMAX || bytestart > pagestart || byteend < pageend)
+		return;
+	const handler_entry &handler = table.handler(entrynum);
+	if (handler.ramptr() == nullptr || handler.byteoffset(pageend) - handler.byteoffset(pagestart) != TLB_PAGE_MASK)
+		return;
+
+	entry.m_base = handler.ramptr(handler.byteoffset(pagestart));
+}
+
+
 //-------------------------------------------------
 //  dump_map - dump the contents of a single
 //  address space
@@ -2802,6 +2873,7 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 	// recompute any direct access on this space if it is a read modification
 	m_space.m_direct->force_update(entry);
+	m_space.tlb_flush();
 
 	//  verify_reference_counts();
 }
@@ -2928,6 +3000,7 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 		// recompute any direct access on this space if it is a read modification
 		m_space.m_direct->force_update(entry);
+		m_space.tlb_flush();
 	}
 
 	// Ranges in range_partial must duplicated then partially changed
@@ -2971,6 +3044,7 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 			// recompute any direct access on this space if it is a read modification
 			m_space.m_direct->force_update(entry);
+			m_space.tlb_flush();
 		}
 	}
 
@@ -3985,6 +4059,21 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 }
 
 
+//-------------------------------------------------
+//  verify_execute_groups - refuse to change a bank
+//  that a device in another execute group may be
+//  reading through at the same time
+//-------------------------------------------------
+
+void memory_bank::verify_execute_groups()
+{
+	device_scheduler &scheduler = m_machine.scheduler();
+	for (bank_reference &ref : m_reflist)
+		if (scheduler.crosses_execute_groups(ref.space().device()))
+			throw emu_fatalerror("Bank '%s' switched from outside the execute group of '%s', which maps it\n", m_tag.c_str(), ref.space().device().tag());
+}
+
+
 //-------------------------------------------------
 //  invalidate_references - force updates on all
 //  referencing address spaces
@@ -3992,9 +4081,12 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 
 void memory_bank::invalidate_references()
 {
-	// invalidate all the direct references to any referenced address spaces
+	// invalidate all the direct references and TLBs of any referenced address spaces
 	for (bank_reference &ref : m_reflist)
+	{
 		ref.space().direct().force_update();
+		ref.space().tlb_flush();
+	}
 }
 
 
@@ -4007,6 +4099,7 @@ void memory_bank::set_base(void *base)
 	// NULL is not an option
 	if (base == nullptr)
 		throw emu_fatalerror("memory_bank::set_base called NULL base");
+	verify_execute_groups();
 
 	// set the base and invalidate any referencing spaces
 	*m_baseptr = reinterpret_cast<UINT8 *>(base);
@@ -4028,6 +4121,7 @@ void memory_bank::set_entry(int entrynum)
 		throw emu_fatalerror("memory_bank::set_entry called with out-of-range entry %d", entrynum);
 	if (m_entry[entrynum].m_ptr == nullptr)
 		throw emu_fatalerror("memory_bank::set_entry called for bank '%s' with invalid bank entry %d", m_tag.c_str(), entrynum);
+	verify_execute_groups();
 
 	m_curentry = entrynum;
 	*m_baseptr = m_entry[entrynum].m_ptr;
@@ -4099,6 +4193,9 @@ memory_region::memory_region(running_machine &machine, const char *name, UINT32
 		m_next(nullptr),
 		m_name(name),
 		m_buffer(length),
+		m_mapping(nullptr),
+		m_base(m_buffer.data()),
+		m_length(length),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
@@ -4107,6 +4204,32 @@ memory_region::memory_region(running_machine &machine, const char *name, UINT32
 }
 
 
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+	if (m_mapping != nullptr)
+		osd_file::unmap(m_mapping, m_length);
+}
+
+
+//-------------------------------------------------
+//  attach_mapping - replace the region's buffer
+//  with a copy-on-write file mapping of the same
+//  length; the region takes ownership of it
+//-------------------------------------------------
+
+void memory_region::attach_mapping(void *mapping)
+{
+	assert(m_mapping == nullptr);
+	m_mapping = mapping;
+	m_base = reinterpret_cast<UINT8 *>(mapping);
+	dynamic_buffer().swap(m_buffer);
+}
+
+
 
 //**************************************************************************
 //  HANDLER ENTRY
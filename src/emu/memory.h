@@ -344,6 +344,17 @@ public:
 	// Set address. This will invoke setoffset handlers for the respective entries.
 	virtual void set_address(offs_t byteaddress) = 0;
 
+	// TLB-accelerated accessors; aligned accesses to plain RAM/ROM/bank pages bypass the handlers
+	UINT8 read_byte_tlb(offs_t byteaddress) { UINT8 *ptr = tlb_lookup<UINT8>(m_tlb_read, byteaddress, ROW_READ); return (ptr != nullptr) ? *ptr : read_byte(byteaddress); }
+	UINT16 read_word_tlb(offs_t byteaddress) { UINT16 *ptr = tlb_lookup<UINT16>(m_tlb_read, byteaddress, ROW_READ); return (ptr != nullptr) ? *ptr : read_word(byteaddress); }
+	UINT32 read_dword_tlb(offs_t byteaddress) { UINT32 *ptr = tlb_lookup<UINT32>(m_tlb_read, byteaddress, ROW_READ); return (ptr != nullptr) ? *ptr : read_dword(byteaddress); }
+	void write_byte_tlb(offs_t byteaddress, UINT8 data) { UINT8 *ptr = tlb_lookup<UINT8>(m_tlb_write, byteaddress, ROW_WRITE); if (ptr != nullptr) *ptr = data; else write_byte(byteaddress, data); }
+	void write_word_tlb(offs_t byteaddress, UINT16 data) { UINT16 *ptr = tlb_lookup<UINT16>(m_tlb_write, byteaddress, ROW_WRITE); if (ptr != nullptr) *ptr = data; else write_word(byteaddress, data); }
+	void write_dword_tlb(offs_t byteaddress, UINT32 data) { UINT32 *ptr = tlb_lookup<UINT32>(m_tlb_write, byteaddress, ROW_WRITE); if (ptr != nullptr) *ptr = data; else write_dword(byteaddress, data); }
+
+	// forget all cached TLB pages
+	void tlb_flush();
+
 	// address-to-byte conversion helpers
 	offs_t address_to_byte(offs_t address) const { return m_config.addr2byte(address); }
 	offs_t address_to_byte_end(offs_t address) const { return m_config.addr2byte_end(address); }
@@ -444,6 +455,35 @@ public:
 	void locate_memory();
 
 private:
+	// software TLB definitions
+	static const int TLB_PAGE_BITS = 8;                                 // bytes per page, log 2
+	static const offs_t TLB_PAGE_MASK = (1 << TLB_PAGE_BITS) - 1;       // mask of the offset within a page
+	static const int TLB_ENTRIES = 256;                                 // number of pages cached per direction
+	static const offs_t TLB_INVALID = 1;                                // tag that never matches a page
+
+	// a TLB entry maps one page to host memory, or to nullptr if it must go through the handlers
+	struct tlb_entry
+	{
+		offs_t                  m_tag;              // byte address of the page held here
+		UINT8 *                 m_base;             // host pointer to the start of the page
+	};
+
+	// look up a naturally aligned access of up to the bus width in the TLB
+	template<typename _Type>
+	_Type *tlb_lookup(tlb_entry *tlb, offs_t byteaddress, read_or_write readorwrite)
+	{
+		if (sizeof(_Type) > m_tlb_maxbytes || (byteaddress & (sizeof(_Type) - 1)) != 0)
+			return nullptr;
+		byteaddress &= m_bytemask;
+		tlb_entry &entry = tlb[(byteaddress >> TLB_PAGE_BITS) & (TLB_ENTRIES - 1)];
+		if (UNEXPECTED(entry.m_tag != (byteaddress & ~TLB_PAGE_MASK)))
+			tlb_fill(entry, byteaddress & ~TLB_PAGE_MASK, readorwrite);
+		if (entry.m_base == nullptr)
+			return nullptr;
+		return reinterpret_cast<_Type *>(entry.m_base + ((byteaddress & TLB_PAGE_MASK) ^ (m_tlb_xor & ~(sizeof(_Type) - 1))));
+	}
+	void tlb_fill(tlb_entry &entry, offs_t pagestart, read_or_write readorwrite);
+
 	// internal helpers
 	virtual address_table_read &read() = 0;
 	virtual address_table_write &write() = 0;
@@ -484,6 +524,10 @@ protected:
 private:
 	memory_manager &        m_manager;          // reference to the owning manager
 	running_machine &       m_machine;          // reference to the owning machine
+	UINT8                   m_tlb_maxbytes;     // widest access the TLB can serve (the bus width)
+	offs_t                  m_tlb_xor;          // byte swizzle for accesses narrower than the bus
+	tlb_entry               m_tlb_read[TLB_ENTRIES];  // software TLB for reads
+	tlb_entry               m_tlb_write[TLB_ENTRIES]; // software TLB for writes
 };
 
 
@@ -606,6 +650,7 @@ public:
 
 private:
 	// internal helpers
+	void verify_execute_groups();
 	void invalidate_references();
 	void expand_entries(int entrynum);
 
@@ -679,15 +724,20 @@ class memory_region
 
 	// construction/destruction
 	memory_region(running_machine &machine, const char *name, UINT32 length, UINT8 width, endianness_t endian);
+	~memory_region();
 
 public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	memory_region *next() const { return m_next; }
-	UINT8 *base() { return &m_buffer[0]; }
-	UINT8 *end() { return base() + m_buffer.size(); }
-	UINT32 bytes() const { return m_buffer.size(); }
+	UINT8 *base() { return m_base; }
+	UINT8 *end() { return m_base + m_length; }
+	UINT32 bytes() const { return m_length; }
 	const char *name() const { return m_name.c_str(); }
+	bool mapped() const { return m_mapping != nullptr; }
+
+	// backing store
+	void attach_mapping(void *mapping);
 
 	// flag expansion
 	endianness_t endianness() const { return m_endianness; }
@@ -695,7 +745,7 @@ public:
 	UINT8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	UINT8 &u8(offs_t offset = 0) { return m_buffer[offset]; }
+	UINT8 &u8(offs_t offset = 0) { return m_base[offset]; }
 	UINT16 &u16(offs_t offset = 0) { return reinterpret_cast<UINT16 *>(base())[offset]; }
 	UINT32 &u32(offs_t offset = 0) { return reinterpret_cast<UINT32 *>(base())[offset]; }
 	UINT64 &u64(offs_t offset = 0) { return reinterpret_cast<UINT64 *>(base())[offset]; }
@@ -706,6 +756,9 @@ private:
 	memory_region *         m_next;
 	std::string             m_name;
 	dynamic_buffer          m_buffer;
+	void *                  m_mapping;
+	UINT8 *                 m_base;
+	UINT32                  m_length;
 	endianness_t            m_endianness;
 	UINT8                   m_bitwidth;
 	UINT8                   m_bytewidth;
@@ -332,10 +332,14 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(nullptr),
 		m_param(nullptr),
-		m_curseq(0)
+		m_curseq(0),
+		m_tracked(false),
+		m_alldirty(true),
+		m_dirtyseq(0),
+		m_lookup_serial(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
-	memset(m_scaled, 0, sizeof(m_scaled));
+	m_dirty.set(0, -1, 0, -1);
 }
 
 
@@ -374,13 +378,8 @@ void render_texture::reset(render_manager &manager, texture_scaler_func scaler,
 void render_texture::release()
 {
 	// free all scaled versions
-	for (auto & elem : m_scaled)
-	{
-		m_manager->invalidate_all(elem.bitmap);
-		global_free(elem.bitmap);
-		elem.bitmap = nullptr;
-		elem.seqid = 0;
-	}
+	if (m_manager != nullptr)
+		m_manager->scaled_invalidate(*this);
 
 	// invalidate references to the original bitmap as well
 	m_manager->invalidate_all(m_bitmap);
@@ -388,6 +387,10 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_tracked = false;
+	m_alldirty = true;
+	m_dirty.set(0, -1, 0, -1);
+	m_dirtyseq = 0;
 }
 
 
@@ -412,17 +415,57 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	m_sbounds = sbounds;
 	m_format = format;
 
-	// invalidate all scaled versions
-	for (auto & elem : m_scaled)
-	{
-		if (elem.bitmap != nullptr)
-		{
-			m_manager->invalidate_all(elem.bitmap);
-			global_free(elem.bitmap);
-		}
-		elem.bitmap = nullptr;
-		elem.seqid = 0;
-	}
+	// everything has changed
+	m_alldirty = true;
+	invalidate_scaled();
+}
+
+
+//-------------------------------------------------
+//  mark_dirty - note that part of the source
+//  bitmap changed, in bitmap coordinates
+//-------------------------------------------------
+
+void render_texture::mark_dirty(const rectangle &rect)
+{
+	rectangle clipped = rect;
+	clipped &= m_sbounds;
+	if (clipped.empty())
+		return;
+
+	// accumulate a single bounding box
+	if (m_dirty.empty())
+		m_dirty = clipped;
+	else
+		m_dirty |= clipped;
+
+	// scaled versions have to be regenerated
+	invalidate_scaled();
+}
+
+
+//-------------------------------------------------
+//  invalidate_scaled - throw out all scaled
+//  versions of the texture
+//-------------------------------------------------
+
+void render_texture::invalidate_scaled()
+{
+	m_manager->scaled_invalidate(*this);
+}
+
+
+//-------------------------------------------------
+//  scale - run the scaler to fill a bitmap of
+//  the requested size
+//-------------------------------------------------
+
+void render_texture::scale(bitmap_argb32 &dest)
+{
+	// make sure we can recover the original argb32 bitmap
+	bitmap_argb32 dummy;
+	bitmap_argb32 &srcbitmap = (m_bitmap != nullptr) ? downcast<bitmap_argb32 &>(*m_bitmap) : dummy;
+	(*m_scaler)(dest, srcbitmap, m_sbounds, m_param);
 }
 
 
@@ -443,7 +486,7 @@ void render_texture::hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const
 //  get_scaled - get a scaled bitmap (if we can)
 //-------------------------------------------------
 
-void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, UINT32 flags)
+void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, UINT32 flags, UINT32 lookup_serial)
 {
 	// source width/height come from the source bounds
 	int swidth = m_sbounds.width();
@@ -465,52 +508,29 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.width = swidth;
 		texinfo.height = sheight;
 		// palette will be set later
-		texinfo.seqid = ++m_curseq;
-	}
-	else
-	{
-		// make sure we can recover the original argb32 bitmap
-		bitmap_argb32 dummy;
-		bitmap_argb32 &srcbitmap = (m_bitmap != nullptr) ? downcast<bitmap_argb32 &>(*m_bitmap) : dummy;
-
-		// is it a size we already have?
-		scaled_texture *scaled = nullptr;
-		int scalenum;
-		for (scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-		{
-			scaled = &m_scaled[scalenum];
-
-			// we need a non-NULL bitmap with matching dest size
-			if (scaled->bitmap != nullptr && dwidth == scaled->bitmap->width() && dheight == scaled->bitmap->height())
-				break;
-		}
 
-		// did we get one?
-		if (scalenum == ARRAY_LENGTH(m_scaled))
+		// hand out a new sequence number only if something changed since the last one;
+		// a change to the lookup tables means every pixel may look different
+		if (!m_tracked || m_alldirty || !m_dirty.empty() || lookup_serial != m_lookup_serial || m_dirtyseq == 0)
 		{
-			int lowest = -1;
-
-			// didn't find one -- take the entry with the lowest seqnum
-			for (scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-				if ((lowest == -1 || m_scaled[scalenum].seqid < m_scaled[lowest].seqid) && !primlist.has_reference(m_scaled[scalenum].bitmap))
-					lowest = scalenum;
-			assert_always(lowest != -1, "Too many live texture instances!");
-
-			// throw out any existing entries
-			scaled = &m_scaled[lowest];
-			if (scaled->bitmap != nullptr)
-			{
-				m_manager->invalidate_all(scaled->bitmap);
-				global_free(scaled->bitmap);
-			}
-
-			// allocate a new bitmap
-			scaled->bitmap = global_alloc(bitmap_argb32(dwidth, dheight));
-			scaled->seqid = ++m_curseq;
-
-			// let the scaler do the work
-			(*m_scaler)(*scaled->bitmap, srcbitmap, m_sbounds, m_param);
+			if (!m_tracked || m_alldirty || lookup_serial != m_lookup_serial)
+				m_dirtyreport.set(0, swidth - 1, 0, sheight - 1);
+			else
+				m_dirtyreport.set(m_dirty.min_x - m_sbounds.min_x, m_dirty.max_x - m_sbounds.min_x, m_dirty.min_y - m_sbounds.min_y, m_dirty.max_y - m_sbounds.min_y);
+			m_dirtyseq = ++m_curseq;
+			m_alldirty = false;
+			m_dirty.set(0, -1, 0, -1);
+			m_lookup_serial = lookup_serial;
 		}
+		texinfo.seqid = m_dirtyseq;
+		texinfo.dirty = m_dirtyreport;
+	}
+	else
+	{
+		// is it a size we already have? if not, have the manager make one
+		render_manager::scaled_texture *scaled = m_manager->scaled_find(*this, dwidth, dheight);
+		if (scaled == nullptr)
+			scaled = &m_manager->scaled_alloc(*this, dwidth, dheight, primlist);
 
 		// finally fill out the new info
 		primlist.add_reference(scaled->bitmap);
@@ -520,6 +540,7 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.height = dheight;
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
+		texinfo.dirty.set(0, dwidth - 1, 0, dheight - 1);
 	}
 }
 
@@ -573,7 +594,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 		m_manager(manager),
 		m_screen(screen),
 		m_overlaybitmap(nullptr),
-		m_overlaytexture(nullptr)
+		m_overlaytexture(nullptr),
+		m_lookup_serial(0)
 {
 	// make sure it is empty
 	empty();
@@ -799,6 +821,8 @@ render_container::item &render_container::add_generic(UINT8 type, float x0, floa
 
 void render_container::recompute_lookups()
 {
+	m_lookup_serial++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -851,6 +875,7 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_lookup_serial++;
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -1432,6 +1457,9 @@ render_primitive_list &render_target::get_primitives()
 		add_container_primitives(list, ui_xform, m_manager.ui_container(), BLENDMODE_ALPHA);
 	}
 
+	// textures scaled in the background have to be complete before anyone draws them
+	m_manager.scaled_wait();
+
 	// optimize the list before handing it off
 	add_clear_and_optimize_primitive_list(list);
 	list.release_lock();
@@ -1856,7 +1884,7 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					width = MIN(width, m_maxtexwidth);
 					height = MIN(height, m_maxtexheight);
 
-					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
+					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags(), container.lookup_serial());
 
 					// set the palette
 					prim->texture.palette = curitem.texture()->get_adjusted_palette(container);
@@ -2511,6 +2539,8 @@ done:
 render_manager::render_manager(running_machine &machine)
 	: m_machine(machine),
 		m_ui_target(nullptr),
+		m_scaled_bytes(0),
+		m_scaled_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI)),
 		m_live_textures(0),
 		m_ui_container(global_alloc(render_container(*this)))
 {
@@ -2536,6 +2566,12 @@ render_manager::~render_manager()
 
 	// better not be any outstanding textures when we die
 	assert(m_live_textures == 0);
+
+	// freeing the textures emptied the scaled texture cache
+	assert(m_scaled_map.empty());
+	if (m_scaled_queue != nullptr)
+		osd_work_queue_free(m_scaled_queue);
+	m_scaled_queue = nullptr;
 }
 
 
@@ -2729,6 +2765,131 @@ void render_manager::invalidate_all(void *refptr)
 }
 
 
+//-------------------------------------------------
+//  scaled_find - look up a scaled variant of a
+//  texture, marking it as recently used
+//-------------------------------------------------
+
+render_manager::scaled_texture *render_manager::scaled_find(render_texture &texture, UINT32 width, UINT32 height)
+{
+	auto found = m_scaled_map.find(scaled_key(&texture, width, height));
+	if (found == m_scaled_map.end())
+		return nullptr;
+
+	scaled_texture &scaled = found->second;
+	m_scaled_lru.splice(m_scaled_lru.end(), m_scaled_lru, scaled.lru);
+	return &scaled;
+}
+
+
+//-------------------------------------------------
+//  scaled_alloc - create a new scaled variant of
+//  a texture, evicting the least recently used
+//  variants that are over budget
+//-------------------------------------------------
+
+render_manager::scaled_texture &render_manager::scaled_alloc(render_texture &texture, UINT32 width, UINT32 height, render_primitive_list &primlist)
+{
+	// evict old entries until the new one fits; anything the list being built
+	// refers to has to stay, which may leave us over budget for a while
+	UINT64 bytes = UINT64(width) * height * sizeof(UINT32);
+	for (auto lru = m_scaled_lru.begin(); lru != m_scaled_lru.end() && m_scaled_bytes + bytes > SCALED_TEXTURE_BUDGET; )
+	{
+		scaled_texture &victim = **lru++;
+		if (!primlist.has_reference(victim.bitmap))
+			scaled_free(m_scaled_map.find(scaled_key(victim.texture, victim.bitmap->width(), victim.bitmap->height())));
+	}
+
+	// allocate the new entry and its bitmap
+	scaled_texture &scaled = m_scaled_map[scaled_key(&texture, width, height)];
+	scaled.texture = &texture;
+	scaled.bitmap = global_alloc(bitmap_argb32(width, height));
+	scaled.seqid = ++texture.m_curseq;
+	scaled.pending = nullptr;
+	scaled.lru = m_scaled_lru.insert(m_scaled_lru.end(), &scaled);
+	m_scaled_bytes += bytes;
+
+	// the generic scaler only reads the source bitmap, so it can run on another
+	// thread until the primitive list is finished; other scalers may touch shared
+	// state and run here
+	if (texture.m_scaler == render_texture::hq_scale && m_scaled_queue != nullptr)
+		scaled.pending = osd_work_item_queue(m_scaled_queue, scaled_texture_callback, &scaled, 0);
+	if (scaled.pending != nullptr)
+		m_scaled_pending.push_back(&scaled);
+	else
+		texture.scale(*scaled.bitmap);
+	return scaled;
+}
+
+
+//-------------------------------------------------
+//  scaled_invalidate - free all scaled variants
+//  of a texture
+//-------------------------------------------------
+
+void render_manager::scaled_invalidate(render_texture &texture)
+{
+	auto entry = m_scaled_map.lower_bound(scaled_key(&texture, 0, 0));
+	while (entry != m_scaled_map.end() && std::get<0>(entry->first) == &texture)
+		scaled_free(entry++);
+}
+
+
+//-------------------------------------------------
+//  scaled_wait - wait for all scaling started in
+//  the background to complete
+//-------------------------------------------------
+
+void render_manager::scaled_wait()
+{
+	for (scaled_texture *scaled : m_scaled_pending)
+	{
+		while (!osd_work_item_wait(scaled->pending, 100 * osd_ticks_per_second())) { }
+		osd_work_item_release(scaled->pending);
+		scaled->pending = nullptr;
+	}
+	m_scaled_pending.clear();
+}
+
+
+//-------------------------------------------------
+//  scaled_free - remove a scaled variant from the
+//  cache and free its bitmap
+//-------------------------------------------------
+
+void render_manager::scaled_free(scaled_map::iterator entry)
+{
+	scaled_texture &scaled = entry->second;
+
+	// finish any scaling still in flight before we free the target
+	if (scaled.pending != nullptr)
+	{
+		while (!osd_work_item_wait(scaled.pending, 100 * osd_ticks_per_second())) { }
+		osd_work_item_release(scaled.pending);
+		m_scaled_pending.erase(std::find(m_scaled_pending.begin(), m_scaled_pending.end(), &scaled));
+	}
+
+	invalidate_all(scaled.bitmap);
+	m_scaled_bytes -= UINT64(scaled.bitmap->width()) * scaled.bitmap->height() * sizeof(UINT32);
+	global_free(scaled.bitmap);
+	m_scaled_lru.erase(scaled.lru);
+	m_scaled_map.erase(entry);
+}
+
+
+//-------------------------------------------------
+//  scaled_texture_callback - work queue entry
+//  point for scaling in the background
+//-------------------------------------------------
+
+void *render_manager::scaled_texture_callback(void *param, int threadid)
+{
+	scaled_texture &scaled = *reinterpret_cast<scaled_texture *>(param);
+	scaled.texture->scale(*scaled.bitmap);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  resolve_tags - resolve tag lookups
 //-------------------------------------------------
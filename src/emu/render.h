@@ -49,7 +49,10 @@
 //#include "osdepend.h"
 
 #include <math.h>
+#include <list>
+#include <map>
 #include <mutex>
+#include <tuple>
 
 
 //**************************************************************************
@@ -216,6 +219,7 @@ struct render_texinfo
 	UINT32              width;              // width of the image
 	UINT32              height;             // height of the image
 	UINT32              seqid;              // sequence ID
+	rectangle           dirty;              // area changed since seqid - 1, relative to the texture
 	UINT64              osddata;            // aux data to pass to osd
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
 };
@@ -444,23 +448,20 @@ public:
 	// set any necessary aux data
 	void set_osd_data(UINT64 data) { m_osddata = data; }
 
+	// dirty tracking; untracked textures are assumed to change every time they are drawn
+	void set_dirty_tracking(bool enable) { m_tracked = enable; m_alldirty = true; }
+	void mark_dirty(const rectangle &rect);
+
 	// generic high-quality bitmap scaler
 	static void hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
 private:
 	// internal helpers
-	void get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, UINT32 flags = 0);
+	void get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, UINT32 flags = 0, UINT32 lookup_serial = 0);
+	void invalidate_scaled();
+	void scale(bitmap_argb32 &dest);
 	const rgb_t *get_adjusted_palette(render_container &container);
 
-	static const int MAX_TEXTURE_SCALES = 16;
-
-	// a scaled_texture contains a single scaled entry for a texture
-	struct scaled_texture
-	{
-		bitmap_argb32 *     bitmap;                 // final bitmap
-		UINT32              seqid;                  // sequence number
-	};
-
 	// internal state
 	render_manager *    m_manager;                  // reference to our manager
 	render_texture *    m_next;                     // next texture (for free list)
@@ -473,7 +474,14 @@ private:
 	texture_scaler_func m_scaler;                   // scaling callback
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
-	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
+
+	// dirty tracking state
+	bool                m_tracked;                  // is the owner reporting changes?
+	bool                m_alldirty;                 // has everything changed?
+	rectangle           m_dirty;                    // area changed since the last sequence number
+	UINT32              m_dirtyseq;                 // sequence number handed out for the current contents
+	rectangle           m_dirtyreport;              // area reported with m_dirtyseq
+	UINT32              m_lookup_serial;            // lookup table serial at m_dirtyseq
 };
 
 
@@ -541,6 +549,7 @@ public:
 	UINT8 apply_brightness_contrast_gamma(UINT8 value);
 	float apply_brightness_contrast_gamma_fp(float value);
 	const rgb_t *bcg_lookup_table(int texformat, palette_t *palette = nullptr);
+	UINT32 lookup_serial() const { return m_lookup_serial; }
 
 private:
 	// an item describes a high level primitive that is added to a container
@@ -595,6 +604,7 @@ private:
 	std::unique_ptr<palette_client> m_palclient;       // client to the screen palette
 	std::vector<rgb_t>           m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	UINT32                  m_lookup_serial;        // bumped whenever either lookup table changes
 };
 
 
@@ -1036,6 +1046,7 @@ private:
 class render_manager
 {
 	friend class render_target;
+	friend class render_texture;
 
 public:
 	// construction/destruction
@@ -1087,6 +1098,29 @@ private:
 	void config_load(config_type cfg_type, xml_data_node *parentnode);
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
+	// a scaled_texture holds one scaled variant of a texture in the shared cache
+	struct scaled_texture
+	{
+		render_texture *    texture;                // texture we were scaled from
+		bitmap_argb32 *     bitmap;                 // final bitmap
+		UINT32              seqid;                  // sequence number
+		osd_work_item *     pending;                // scaling still in progress, or nullptr
+		std::list<scaled_texture *>::iterator lru;  // position in the LRU list
+	};
+	typedef std::tuple<render_texture *, UINT32, UINT32> scaled_key;
+	typedef std::map<scaled_key, scaled_texture> scaled_map;
+
+	// total size of scaled variants we try to stay under
+	static const UINT64 SCALED_TEXTURE_BUDGET = 128 * 1024 * 1024;
+
+	// scaled texture cache
+	scaled_texture *scaled_find(render_texture &texture, UINT32 width, UINT32 height);
+	scaled_texture &scaled_alloc(render_texture &texture, UINT32 width, UINT32 height, render_primitive_list &primlist);
+	void scaled_invalidate(render_texture &texture);
+	void scaled_wait();
+	void scaled_free(scaled_map::iterator entry);
+	static void *scaled_texture_callback(void *param, int threadid);
+
 	// internal state
 	running_machine &               m_machine;          // reference back to the machine
 
@@ -1094,6 +1128,13 @@ private:
 	simple_list<render_target>      m_targetlist;       // list of targets
 	render_target *                 m_ui_target;        // current UI target
 
+	// scaled texture cache; declared ahead of the allocator, since textures it destroys release their entries
+	scaled_map                      m_scaled_map;       // scaled variants, by texture and size
+	std::list<scaled_texture *>     m_scaled_lru;       // scaled variants, least recently used first
+	std::vector<scaled_texture *>   m_scaled_pending;   // variants still being scaled
+	UINT64                          m_scaled_bytes;     // total size of all scaled variants
+	osd_work_queue *                m_scaled_queue;     // queue for scaling in the background
+
 	// texture lists
 	UINT32                          m_live_textures;    // number of live textures
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
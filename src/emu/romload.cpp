@@ -40,9 +40,9 @@ static osd_file::error common_process_file(emu_options &options, const char *loc
 	return filerr;
 }
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, osd_file::error &filerr)
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, osd_file::error &filerr, UINT32 openflags)
 {
-	auto image_file = std::make_unique<emu_file>(options.media_path(), OPEN_FLAG_READ);
+	auto image_file = std::make_unique<emu_file>(options.media_path(), openflags);
 
 	if (has_crc)
 		filerr = image_file->open(location, PATH_SEPARATOR, ROM_GETNAME(romp), crc);
@@ -430,8 +430,19 @@ void rom_load_manager::verify_length_and_hash(const char *name, UINT32 explength
 		m_warnings++;
 	}
 
+	/* verify checksums */
+	verify_hash(name, hashes, m_file->hashes(hashes.hash_types().c_str()));
+}
+
+
+/*-------------------------------------------------
+    verify_hash - compare the hash signatures of
+    a file against the expected ones
+-------------------------------------------------*/
+
+void rom_load_manager::verify_hash(const char *name, const hash_collection &hashes, const hash_collection &acthashes)
+{
 	/* If there is no good dump known, write it */
-	hash_collection &acthashes = m_file->hashes(hashes.hash_types().c_str());
 	if (hashes.flag(hash_collection::FLAG_NO_DUMP))
 	{
 		m_errorstring.append(string_format("%s NO GOOD DUMP KNOWN\n", name));
@@ -553,6 +564,9 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 	UINT32 romsize = rom_file_size(romp);
 	tried_file_names = "";
 
+	/* leave stored ZIP members unloaded if we may be able to map them */
+	UINT32 openflags = m_region_mappable ? (OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD) : OPEN_FLAG_READ;
+
 	/* update status display */
 	display_loading_rom_message(ROM_GETNAME(romp), from_list);
 
@@ -567,7 +581,7 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr, openflags);
 	}
 
 	/* if the region is load by name, load the ROM from there */
@@ -620,7 +634,7 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr, openflags);
 		}
 		else
 		{
@@ -628,25 +642,25 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from list/parentname
 			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from setname
 			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from parentname
 			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 		}
 	}
@@ -795,6 +809,134 @@ int rom_load_manager::read_rom_data(const rom_entry *parent_region, const rom_en
 }
 
 
+/*-------------------------------------------------
+    region_is_mappable - determine whether a
+    region is loaded from a single file that
+    covers it exactly and needs no interleaving
+    or post-processing, so that it can be backed
+    directly by a mapping of the file
+-------------------------------------------------*/
+
+bool rom_load_manager::region_is_mappable(const rom_entry *region, UINT8 width, endianness_t endian)
+{
+	const rom_entry *romp = region + 1;
+
+	/* exactly one file, with no continues, reloads, fills or copies */
+	if (!ROMENTRY_ISFILE(romp) || !ROMENTRY_ISREGIONEND(romp + 1))
+		return false;
+
+	/* nothing for region_post_process to do */
+	if (ROMREGION_ISINVERTED(region) || (width > 1 && endian != ENDIANNESS_NATIVE))
+		return false;
+
+	/* a plain load of the whole region */
+	return ROM_GETOFFSET(romp) == 0 && ROM_GETLENGTH(romp) == ROMREGION_GETLENGTH(region) &&
+			!ROM_INHERITSFLAGS(romp) && ROM_GETBIOSFLAGS(romp) == 0 &&
+			ROM_GETBITWIDTH(romp) == 8 && ROM_GETBITSHIFT(romp) == 0 && ROM_GETSKIPCOUNT(romp) == 0 &&
+			(ROM_GETGROUPSIZE(romp) == 1 || !ROM_ISREVERSED(romp));
+}
+
+
+/*-------------------------------------------------
+    map_rom_data - try to back the current region
+    with a mapping of the open file, and queue
+    its checksums to be computed on a worker
+    thread
+-------------------------------------------------*/
+
+bool rom_load_manager::map_rom_data(const rom_entry *romp)
+{
+	void *base;
+	UINT32 length;
+	if (m_file->map(base, length) != osd_file::error::NONE)
+		return false;
+
+	/* a file of the wrong length is read normally so the usual warning is given; a stored
+	   ZIP member can start on any byte, and regions are accessed as wider types, so the
+	   mapping must be aligned for a UINT64 as well */
+	if (length != m_region->bytes() || (reinterpret_cast<FPTR>(base) % sizeof(UINT64)) != 0)
+	{
+		osd_file::unmap(base, length);
+		return false;
+	}
+	m_region->attach_mapping(base);
+	LOG(("Mapped %X bytes @ %p\n", length, base));
+
+	/* allocate the queue on first use */
+	if (m_hash_queue == nullptr)
+		m_hash_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	auto rom = std::make_unique<mapped_rom>();
+	rom->m_name = ROM_GETNAME(romp);
+	rom->m_hashes.from_internal_string(ROM_GETHASHDATA(romp));
+	rom->m_types = rom->m_hashes.hash_types();
+	rom->m_base = m_region->base();
+	rom->m_length = length;
+	rom->m_item = nullptr;
+
+	/* if the hash index already knows this file there is nothing to compute */
+	rom->m_cacheable = m_file->hash_cache_key(rom->m_cachekey, rom->m_cachelength, rom->m_cachemodified);
+	if (!rom->m_cacheable || !file_hash_cache::find(rom->m_cachekey, rom->m_cachelength, rom->m_cachemodified, rom->m_types.c_str(), rom->m_acthashes))
+	{
+		rom->m_item = (m_hash_queue != nullptr) ? osd_work_item_queue(m_hash_queue, hash_mapped_rom, rom.get(), 0) : nullptr;
+		if (rom->m_item == nullptr)
+			hash_mapped_rom(rom.get(), 0);
+	}
+	m_mapped_roms.push_back(std::move(rom));
+	return true;
+}
+
+
+/*-------------------------------------------------
+    hash_mapped_rom - compute the checksums of a
+    mapped ROM; runs on a worker thread
+-------------------------------------------------*/
+
+void *rom_load_manager::hash_mapped_rom(void *param, int threadid)
+{
+	mapped_rom *rom = reinterpret_cast<mapped_rom *>(param);
+	rom->m_acthashes.compute(rom->m_base, rom->m_length, rom->m_types.c_str());
+	if (rom->m_cacheable)
+		file_hash_cache::add(rom->m_cachekey, rom->m_cachelength, rom->m_cachemodified, rom->m_acthashes);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    verify_mapped_roms - wait for the checksums
+    of all mapped ROMs and report mismatches
+-------------------------------------------------*/
+
+void rom_load_manager::verify_mapped_roms()
+{
+	wait_mapped_roms();
+	for (auto &rom : m_mapped_roms)
+		verify_hash(rom->m_name.c_str(), rom->m_hashes, rom->m_acthashes);
+	m_mapped_roms.clear();
+
+	if (m_hash_queue != nullptr)
+		osd_work_queue_free(m_hash_queue);
+	m_hash_queue = nullptr;
+}
+
+
+/*-------------------------------------------------
+    wait_mapped_roms - wait for any outstanding
+    checksums of mapped ROMs
+-------------------------------------------------*/
+
+void rom_load_manager::wait_mapped_roms()
+{
+	for (auto &rom : m_mapped_roms)
+		if (rom->m_item != nullptr)
+		{
+			while (!osd_work_item_wait(rom->m_item, osd_ticks_per_second())) { }
+			osd_work_item_release(rom->m_item);
+			rom->m_item = nullptr;
+		}
+}
+
+
 /*-------------------------------------------------
     fill_rom_data - fill a region of ROM space
 -------------------------------------------------*/
@@ -895,6 +1037,15 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 			if (!irrelevantbios && !open_rom_file(regiontag, romp, tried_file_names, from_list))
 				handle_missing_file(romp, tried_file_names, CHDERR_NONE);
 
+			/* if the file fills the whole region as-is, map it instead of reading it */
+			if (m_region_mappable && m_file != nullptr && map_rom_data(romp))
+			{
+				LOG(("Closing ROM file\n"));
+				m_file = nullptr;
+				romp++;
+				continue;
+			}
+
 			/* loop until we run out of reloads */
 			do
 			{
@@ -1358,6 +1509,9 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 			process_disk_entries(regiontag.c_str(), region, region + 1, locationtag.c_str());
 	}
 
+	/* collect the checksums of any mapped ROMs */
+	verify_mapped_roms();
+
 	/* now go back and post-process all the regions */
 	for (region = start_region; region != nullptr; region = rom_next_region(region))
 	{
@@ -1418,12 +1572,17 @@ void rom_load_manager::process_region_list()
 #endif
 
 				/* now process the entries in the region */
+				m_region_mappable = machine().options().map_roms() && region_is_mappable(region, width, endianness);
 				process_rom_entries(device->shortname(), region, region + 1, device, FALSE);
+				m_region_mappable = false;
 			}
 			else if (ROMREGION_ISDISKDATA(region))
 				process_disk_entries(regiontag.c_str(), region, region + 1, nullptr);
 		}
 
+	/* collect the checksums of any mapped ROMs before anything modifies them */
+	verify_mapped_roms();
+
 	/* now go back and post-process all the regions */
 	for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
 		for (const rom_entry *region = rom_first_region(*device); region != nullptr; region = rom_next_region(region))
@@ -1448,7 +1607,9 @@ void rom_load_manager::process_region_list()
 -------------------------------------------------*/
 
 rom_load_manager::rom_load_manager(running_machine &machine)
-	: m_machine(machine)
+	: m_machine(machine),
+		m_region_mappable(false),
+		m_hash_queue(nullptr)
 {
 	/* figure out which BIOS we are using */
 	device_iterator deviter(machine.config().root_device());
@@ -1479,3 +1640,16 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	/* display the results and exit */
 	display_rom_load_results(FALSE);
 }
+
+
+/*-------------------------------------------------
+    ~rom_load_manager - make sure no mapped ROM
+    is still being hashed
+-------------------------------------------------*/
+
+rom_load_manager::~rom_load_manager()
+{
+	wait_mapped_roms();
+	if (m_hash_queue != nullptr)
+		osd_work_queue_free(m_hash_queue);
+}
@@ -279,9 +279,25 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	struct mapped_rom
+	{
+		std::string         m_name;                 /* name of the ROM */
+		hash_collection     m_hashes;               /* expected hashes */
+		std::string         m_types;                /* hash types to compute */
+		hash_collection     m_acthashes;            /* computed hashes */
+		const UINT8 *       m_base;                 /* mapped data */
+		UINT32              m_length;               /* length of mapped data */
+		osd_work_item *     m_item;                 /* work item computing the hashes */
+		bool                m_cacheable;            /* can the hashes go in the file hash cache? */
+		std::string         m_cachekey;             /* file hash cache key, size and timestamp */
+		UINT64              m_cachelength;
+		INT64               m_cachemodified;
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
+	~rom_load_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -311,12 +327,18 @@ private:
 	void handle_missing_file(const rom_entry *romp, std::string tried_file_names, chd_error chderr);
 	void dump_wrong_and_correct_checksums(const hash_collection &hashes, const hash_collection &acthashes);
 	void verify_length_and_hash(const char *name, UINT32 explength, const hash_collection &hashes);
+	void verify_hash(const char *name, const hash_collection &hashes, const hash_collection &acthashes);
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
 	int rom_fread(UINT8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
+	bool region_is_mappable(const rom_entry *region, UINT8 width, endianness_t endian);
+	bool map_rom_data(const rom_entry *romp);
+	void verify_mapped_roms();
+	void wait_mapped_roms();
+	static void *hash_mapped_rom(void *param, int threadid);
 	void fill_rom_data(const rom_entry *romp);
 	void copy_rom_data(const rom_entry *romp);
 	void process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list);
@@ -342,6 +364,9 @@ private:
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
 	memory_region * m_region;             /* info about current region */
+	bool            m_region_mappable;    /* can the current region be backed by a file mapping? */
+	osd_work_queue * m_hash_queue;        /* queue for hashing mapped ROMs */
+	std::vector<std::unique_ptr<mapped_rom>> m_mapped_roms; /* mapped ROMs awaiting verification */
 
 	std::string     m_errorstring;        /* error string */
 	std::string     m_softwarningstring;  /* software warning string */
@@ -350,7 +375,7 @@ private:
 
 /* ----- Helpers ----- */
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, osd_file::error &filerr);
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, osd_file::error &filerr, UINT32 openflags = OPEN_FLAG_READ);
 
 /* return pointer to the first ROM region within a source */
 const rom_entry *rom_first_region(const device_t &device);
@@ -11,20 +11,42 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Number of chunks (little-endian)
+    24..    Chunk index: for each chunk, its uncompressed and stored
+            sizes as little-endian 32-bit values
+    ....end Chunk data, in index order
+
+    The registered entries are concatenated and split into chunks of
+    CHUNK_SIZE bytes, each compressed independently with zlib so that
+    they can be processed in parallel. A chunk whose stored size equals
+    its uncompressed size is stored raw. Format 2 files, which hold the
+    whole blob as a single compressed stream, can still be read.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+****************************************************************************
+
+    Rewind buffer:
+
+    When enabled, a snapshot of the registered state is taken at the
+    end of every frame and kept in an in-memory ring. Every Nth
+    snapshot is a keyframe holding all of the state; the ones in
+    between only hold the pages (entries, or PAGE_SIZE pieces of big
+    entries) that differ from the most recent keyframe. Stepping back
+    restores the keyframe and then overlays a single delta on top.
+
 ***************************************************************************/
 
 #include "emu.h"
 #include "coreutil.h"
 
+#include <zlib.h>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -40,7 +62,8 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int LEGACY_VERSION    = 2;
 const int HEADER_SIZE       = 32;
 
 // Available flags
@@ -51,6 +74,8 @@ enum
 
 #define STATE_MAGIC_NUM         "MAMESAVE"
 
+
+
 //**************************************************************************
 //  INITIALIZATION
 //**************************************************************************
@@ -62,11 +87,24 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_chunk_queue(nullptr),
+		m_rewind_pending(false)
 {
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+	if (m_chunk_queue != nullptr)
+		osd_work_queue_free(m_chunk_queue);
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -77,7 +115,17 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
 		dump_registry();
+
+		// now that every entry is known, set up the rewind buffer if requested
+		emu_options &options = machine().options();
+		if (options.rewind() > 0 && m_rewind == nullptr && m_illegal_regs == 0)
+		{
+			m_rewind = std::make_unique<rewind_buffer>(*this, options.rewind(), options.rewind_keyframe(), options.rewind_compress());
+			machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(save_manager::rewind_frame), this));
+		}
+	}
 }
 
 
@@ -241,7 +289,6 @@ save_error save_manager::read_file(emu_file &file)
 	UINT8 header[HEADER_SIZE];
 	if (file.read(header, sizeof(header)) != sizeof(header))
 		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// verify the header and report an error if it doesn't match
 	UINT32 sig = signature();
@@ -251,6 +298,71 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// older files are a single compressed stream
+	if (header[8] == LEGACY_VERSION)
+		return read_legacy_file(file, flip);
+
+	// read the chunk index and make sure it matches our layout
+	build_chunks();
+	UINT8 countbuf[4];
+	if (file.read(countbuf, sizeof(countbuf)) != sizeof(countbuf))
+		return STATERR_READ_ERROR;
+	if (get_le32(countbuf) != m_chunks.size())
+		return STATERR_INVALID_HEADER;
+	std::vector<UINT8> index(m_chunks.size() * 8);
+	if (!index.empty() && file.read(&index[0], index.size()) != index.size())
+		return STATERR_READ_ERROR;
+
+	// read the chunk data
+	for (int chunknum = 0; chunknum < m_chunks.size(); chunknum++)
+	{
+		save_chunk &chunk = *m_chunks[chunknum];
+		UINT32 rawsize = get_le32(&index[chunknum * 8 + 0]);
+		UINT32 storedsize = get_le32(&index[chunknum * 8 + 4]);
+		if (rawsize != chunk.m_rawsize || storedsize > rawsize)
+			return STATERR_INVALID_HEADER;
+
+		chunk.m_valid = false;
+		chunk.m_raw.resize(rawsize);
+		std::vector<UINT8> &dest = (storedsize == rawsize) ? chunk.m_raw : chunk.m_compressed;
+		dest.resize(storedsize);
+		if (storedsize == rawsize)
+			chunk.m_compressed.clear();
+		if (storedsize != 0 && file.read(&dest[0], storedsize) != storedsize)
+			return STATERR_READ_ERROR;
+	}
+
+	// decompress and scatter them in parallel
+	process_chunks(decompress_chunk);
+	for (auto &chunk : m_chunks)
+		if (chunk->m_error)
+			return STATERR_READ_ERROR;
+
+	// handle flipping; the cached contents no longer match the live data
+	if (flip)
+	{
+		for (state_entry &entry : m_entry_list)
+			entry.flip_data();
+		for (auto &chunk : m_chunks)
+			chunk->m_valid = false;
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_legacy_file - read the data from a
+//  format 2 file, after the header
+//-------------------------------------------------
+
+save_error save_manager::read_legacy_file(emu_file &file, bool flip)
+{
+	file.compress(FCOMPRESS_MEDIUM);
+
 	// read all the data, flipping if necessary
 	for (state_entry &entry : m_entry_list)
 	{
@@ -263,6 +375,10 @@ save_error save_manager::read_file(emu_file &file)
 			entry.flip_data();
 	}
 
+	// the chunk cache no longer matches the live data
+	for (auto &chunk : m_chunks)
+		chunk->m_valid = false;
+
 	// call the post-load functions
 	dispatch_postload();
 
@@ -300,27 +416,220 @@ save_error save_manager::write_file(emu_file &file)
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
 
-	// write the header and turn on compression for the rest of the file
+	// write the header; chunks are compressed individually
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	if (file.write(header, sizeof(header)) != sizeof(header))
 		return STATERR_WRITE_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// call the pre-save functions
 	dispatch_presave();
 
+	// compress the chunks in parallel; unchanged ones are reused from last time
+	build_chunks();
+	process_chunks(compress_chunk);
+
+	// write the chunk index
+	std::vector<UINT8> index(4 + m_chunks.size() * 8);
+	put_le32(&index[0], m_chunks.size());
+	for (int chunknum = 0; chunknum < m_chunks.size(); chunknum++)
+	{
+		save_chunk &chunk = *m_chunks[chunknum];
+		put_le32(&index[4 + chunknum * 8 + 0], chunk.m_rawsize);
+		put_le32(&index[4 + chunknum * 8 + 4], chunk.m_compressed.empty() ? chunk.m_rawsize : chunk.m_compressed.size());
+	}
+	if (file.write(&index[0], index.size()) != index.size())
+		return STATERR_WRITE_ERROR;
+
 	// then write all the data
-	for (state_entry &entry : m_entry_list)
+	for (auto &chunk : m_chunks)
 	{
-		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
-		if (file.write(entry.m_data, totalsize) != totalsize)
+		const std::vector<UINT8> &data = chunk->m_compressed.empty() ? chunk->m_raw : chunk->m_compressed;
+		if (!data.empty() && file.write(&data[0], data.size()) != data.size())
 			return STATERR_WRITE_ERROR;
 	}
 	return STATERR_NONE;
 }
 
 
+//-------------------------------------------------
+//  build_chunks - split the registered entries
+//  into chunks, once registration has closed
+//-------------------------------------------------
+
+void save_manager::build_chunks()
+{
+	if (!m_chunks.empty() || m_entry_list.first() == nullptr)
+		return;
+
+	for (state_entry &entry : m_entry_list)
+	{
+		UINT8 *data = reinterpret_cast<UINT8 *>(entry.m_data);
+		UINT32 remaining = entry.m_typesize * entry.m_typecount;
+		while (remaining > 0)
+		{
+			// start a new chunk when the current one is full
+			if (m_chunks.empty() || m_chunks.back()->m_rawsize == CHUNK_SIZE)
+			{
+				m_chunks.push_back(std::make_unique<save_chunk>());
+				save_chunk &chunk = *m_chunks.back();
+				chunk.m_rawsize = 0;
+				chunk.m_valid = false;
+				chunk.m_error = false;
+				chunk.m_item = nullptr;
+			}
+			save_chunk &chunk = *m_chunks.back();
+
+			chunk_span span;
+			span.m_data = data;
+			span.m_length = MIN(remaining, CHUNK_SIZE - chunk.m_rawsize);
+			chunk.m_spans.push_back(span);
+			chunk.m_rawsize += span.m_length;
+			data += span.m_length;
+			remaining -= span.m_length;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  process_chunks - run a callback over every
+//  chunk on the work queue and wait for them all
+//-------------------------------------------------
+
+void save_manager::process_chunks(osd_work_callback callback)
+{
+	if (m_chunk_queue == nullptr && m_chunks.size() > 1)
+		m_chunk_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	// queue everything, falling back to doing the work here
+	for (auto &chunk : m_chunks)
+	{
+		chunk->m_error = false;
+		chunk->m_item = (m_chunk_queue != nullptr) ? osd_work_item_queue(m_chunk_queue, callback, chunk.get(), 0) : nullptr;
+		if (chunk->m_item == nullptr)
+			(*callback)(chunk.get(), 0);
+	}
+
+	// then wait for it to finish
+	for (auto &chunk : m_chunks)
+		if (chunk->m_item != nullptr)
+		{
+			while (!osd_work_item_wait(chunk->m_item, osd_ticks_per_second())) { }
+			osd_work_item_release(chunk->m_item);
+			chunk->m_item = nullptr;
+		}
+}
+
+
+//-------------------------------------------------
+//  compress_chunk - gather and compress a chunk
+//  if it changed since the last save or load
+//-------------------------------------------------
+
+void *save_manager::compress_chunk(void *param, int threadid)
+{
+	save_chunk &chunk = *reinterpret_cast<save_chunk *>(param);
+
+	// if the contents haven't changed, the stored result is still good
+	if (chunk.m_valid)
+	{
+		UINT32 offset = 0;
+		bool dirty = false;
+		for (chunk_span &span : chunk.m_spans)
+		{
+			if (memcmp(&chunk.m_raw[offset], span.m_data, span.m_length) != 0)
+			{
+				dirty = true;
+				break;
+			}
+			offset += span.m_length;
+		}
+		if (!dirty)
+			return nullptr;
+	}
+
+	// gather the spans
+	chunk.m_raw.resize(chunk.m_rawsize);
+	UINT32 offset = 0;
+	for (chunk_span &span : chunk.m_spans)
+	{
+		memcpy(&chunk.m_raw[offset], span.m_data, span.m_length);
+		offset += span.m_length;
+	}
+
+	// compress, storing raw if that doesn't help
+	uLongf destlen = compressBound(chunk.m_rawsize);
+	chunk.m_compressed.resize(destlen);
+	if (compress2(&chunk.m_compressed[0], &destlen, &chunk.m_raw[0], chunk.m_rawsize, Z_DEFAULT_COMPRESSION) == Z_OK && destlen < chunk.m_rawsize)
+		chunk.m_compressed.resize(destlen);
+	else
+		chunk.m_compressed.clear();
+	chunk.m_valid = true;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  decompress_chunk - decompress a chunk that
+//  was read from a file and scatter it back to
+//  the live data
+//-------------------------------------------------
+
+void *save_manager::decompress_chunk(void *param, int threadid)
+{
+	save_chunk &chunk = *reinterpret_cast<save_chunk *>(param);
+
+	if (!chunk.m_compressed.empty())
+	{
+		uLongf destlen = chunk.m_rawsize;
+		if (uncompress(&chunk.m_raw[0], &destlen, &chunk.m_compressed[0], chunk.m_compressed.size()) != Z_OK || destlen != chunk.m_rawsize)
+		{
+			chunk.m_error = true;
+			return nullptr;
+		}
+	}
+
+	UINT32 offset = 0;
+	for (chunk_span &span : chunk.m_spans)
+	{
+		memcpy(span.m_data, &chunk.m_raw[offset], span.m_length);
+		offset += span.m_length;
+	}
+
+	// what we just loaded is exactly what a save would produce
+	chunk.m_valid = true;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  rewind_frame - note that a frame has completed
+//-------------------------------------------------
+
+void save_manager::rewind_frame()
+{
+	if (!machine().paused())
+		m_rewind_pending = true;
+}
+
+
+//-------------------------------------------------
+//  update_rewind - capture a rewind snapshot if
+//  a frame has completed; called between
+//  timeslices
+//-------------------------------------------------
+
+void save_manager::update_rewind()
+{
+	// wait until any anonymous timers have gone away, just like a regular save
+	if (!m_rewind_pending || !machine().scheduler().can_save())
+		return;
+	m_rewind_pending = false;
+	m_rewind->capture();
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -374,7 +683,7 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if (header[8] != SAVE_VERSION && header[8] != LEGACY_VERSION)
 	{
 		if (errormsg != nullptr)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
@@ -467,3 +776,246 @@ void state_entry::flip_data()
 			break;
 	}
 }
+
+
+
+//**************************************************************************
+//  REWIND BUFFER
+//**************************************************************************
+
+//-------------------------------------------------
+//  rewind_buffer - constructor
+//-------------------------------------------------
+
+rewind_buffer::rewind_buffer(save_manager &save, UINT32 capacity, UINT32 keyframe_interval, bool compress)
+	: m_save(save),
+		m_capacity(MAX(capacity, 1)),
+		m_keyframe_interval(MIN(MAX(keyframe_interval, 1), m_capacity)),
+		m_compress(compress),
+		m_group_size(0),
+		m_bytes_used(0)
+{
+}
+
+
+//-------------------------------------------------
+//  clear - discard all snapshots
+//-------------------------------------------------
+
+void rewind_buffer::clear()
+{
+	m_snapshots.clear();
+	m_group_size = 0;
+	m_bytes_used = 0;
+}
+
+
+//-------------------------------------------------
+//  capture - append a snapshot of the current
+//  state to the ring
+//-------------------------------------------------
+
+save_error rewind_buffer::capture()
+{
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (m_pages.empty())
+		build_page_table();
+
+	// call the pre-save functions
+	m_save.dispatch_presave();
+
+	m_snapshots.emplace_back();
+	snapshot &snap = m_snapshots.back();
+	snap.m_keyframe = (m_group_size == 0 || m_group_size >= m_keyframe_interval);
+
+	if (snap.m_keyframe)
+	{
+		// a keyframe refreshes the reference image and holds all of it
+		for (state_page &page : m_pages)
+			memcpy(&m_reference[page.m_base], page.m_data, page.m_length);
+		pack(snap, m_reference);
+		m_group_size = 1;
+	}
+	else
+	{
+		// a delta only holds the pages that differ from the reference image
+		std::vector<UINT8> raw;
+		for (UINT32 pagenum = 0; pagenum < m_pages.size(); pagenum++)
+		{
+			state_page &page = m_pages[pagenum];
+			if (memcmp(&m_reference[page.m_base], page.m_data, page.m_length) != 0)
+			{
+				snap.m_pages.push_back(pagenum);
+				raw.insert(raw.end(), page.m_data, page.m_data + page.m_length);
+			}
+		}
+		pack(snap, raw);
+		m_group_size++;
+	}
+	m_bytes_used += snap.m_data.size();
+
+	// trim the ring, but never below the number of snapshots we promised
+	while (m_snapshots.size() - oldest_group_size() >= m_capacity)
+		evict();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  step_back - restore the state captured the
+//  given number of snapshots before the most
+//  recent one (0 restores the most recent) and
+//  discard everything newer; must be called
+//  between timeslices
+//-------------------------------------------------
+
+save_error rewind_buffer::step_back(UINT32 frames)
+{
+	if (frames >= m_snapshots.size())
+		return STATERR_READ_ERROR;
+
+	// drop everything after the target
+	UINT32 target = m_snapshots.size() - 1 - frames;
+	while (m_snapshots.size() > target + 1)
+	{
+		m_bytes_used -= m_snapshots.back().m_data.size();
+		m_snapshots.pop_back();
+	}
+
+	// find the keyframe the target is relative to, and make it the reference again
+	UINT32 keyframe = target;
+	while (!m_snapshots[keyframe].m_keyframe)
+		keyframe--;
+	if (!unpack(m_snapshots[keyframe], m_reference))
+		return STATERR_READ_ERROR;
+	m_group_size = target - keyframe + 1;
+
+	// restore the keyframe, then overlay the delta
+	for (state_page &page : m_pages)
+		memcpy(page.m_data, &m_reference[page.m_base], page.m_length);
+	if (target != keyframe)
+	{
+		const snapshot &snap = m_snapshots[target];
+		std::vector<UINT8> raw;
+		if (!unpack(snap, raw))
+			return STATERR_READ_ERROR;
+		const UINT8 *src = raw.data();
+		for (UINT32 pagenum : snap.m_pages)
+		{
+			state_page &page = m_pages[pagenum];
+			memcpy(page.m_data, src, page.m_length);
+			src += page.m_length;
+		}
+	}
+
+	// call the post-load functions
+	m_save.dispatch_postload();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  build_page_table - split every entry into
+//  pages and size the reference image
+//-------------------------------------------------
+
+void rewind_buffer::build_page_table()
+{
+	UINT32 base = 0;
+	for (state_entry &entry : m_save.m_entry_list)
+	{
+		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
+		for (UINT32 offset = 0; offset < totalsize; offset += PAGE_SIZE)
+		{
+			state_page page;
+			page.m_data = reinterpret_cast<UINT8 *>(entry.m_data) + offset;
+			page.m_length = MIN(totalsize - offset, PAGE_SIZE);
+			page.m_base = base;
+			m_pages.push_back(page);
+			base += page.m_length;
+		}
+	}
+	m_reference.resize(base);
+}
+
+
+//-------------------------------------------------
+//  pack - store page contents in a snapshot,
+//  compressing them if that is enabled and helps
+//-------------------------------------------------
+
+void rewind_buffer::pack(snapshot &snap, const std::vector<UINT8> &raw)
+{
+	snap.m_rawsize = raw.size();
+	snap.m_compressed = false;
+	if (raw.empty())
+		return;
+
+	if (m_compress)
+	{
+		uLongf destlen = compressBound(raw.size());
+		snap.m_data.resize(destlen);
+		if (compress2(&snap.m_data[0], &destlen, &raw[0], raw.size(), Z_BEST_SPEED) == Z_OK && destlen < raw.size())
+		{
+			snap.m_data.resize(destlen);
+			snap.m_data.shrink_to_fit();
+			snap.m_compressed = true;
+			return;
+		}
+	}
+	snap.m_data = raw;
+}
+
+
+//-------------------------------------------------
+//  unpack - retrieve the page contents of a
+//  snapshot
+//-------------------------------------------------
+
+bool rewind_buffer::unpack(const snapshot &snap, std::vector<UINT8> &raw) const
+{
+	if (!snap.m_compressed)
+	{
+		raw = snap.m_data;
+		return true;
+	}
+
+	raw.resize(snap.m_rawsize);
+	uLongf destlen = snap.m_rawsize;
+	return uncompress(&raw[0], &destlen, &snap.m_data[0], snap.m_data.size()) == Z_OK && destlen == snap.m_rawsize;
+}
+
+
+//-------------------------------------------------
+//  oldest_group_size - return the number of
+//  snapshots in the oldest keyframe's group
+//-------------------------------------------------
+
+UINT32 rewind_buffer::oldest_group_size() const
+{
+	UINT32 count = 1;
+	while (count < m_snapshots.size() && !m_snapshots[count].m_keyframe)
+		count++;
+	return count;
+}
+
+
+//-------------------------------------------------
+//  evict - drop the oldest keyframe along with
+//  the deltas that depend on it
+//-------------------------------------------------
+
+void rewind_buffer::evict()
+{
+	do
+	{
+		m_bytes_used -= m_snapshots.front().m_data.size();
+		m_snapshots.pop_front();
+	}
+	while (!m_snapshots.empty() && !m_snapshots.front().m_keyframe);
+
+	if (m_snapshots.empty())
+		m_group_size = 0;
+}
@@ -17,6 +17,9 @@
 #ifndef __SAVE_H__
 #define __SAVE_H__
 
+#include <deque>
+#include <memory>
+
 
 
 //**************************************************************************
@@ -83,8 +86,12 @@ public:
 	UINT32              m_offset;               // offset within the final structure
 };
 
+class rewind_buffer;
+
 class save_manager
 {
+	friend class rewind_buffer;
+
 	// type_checker is a set of templates to identify valid save types
 	template<typename _ItemType> struct type_checker { static const bool is_atom = false; static const bool is_pointer = false; };
 	template<typename _ItemType> struct type_checker<_ItemType*> { static const bool is_atom = false; static const bool is_pointer = true; };
@@ -92,6 +99,7 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -157,9 +165,41 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// rewind buffer
+	rewind_buffer *rewind() const { return m_rewind.get(); }
+	void update_rewind();
+
 private:
+	// states are split into independently compressed chunks of this size
+	static const UINT32 CHUNK_SIZE = 1024 * 1024;
+
+	// a piece of a single state entry that lives in a chunk
+	struct chunk_span
+	{
+		UINT8 *             m_data;                 // pointer to the live data
+		UINT32              m_length;               // length of this span
+	};
+
+	// a chunk of the serialized state
+	struct save_chunk
+	{
+		std::vector<chunk_span> m_spans;            // live data making up this chunk
+		UINT32              m_rawsize;              // total size of the spans
+		std::vector<UINT8>  m_raw;                  // contents as of the last save or load
+		std::vector<UINT8>  m_compressed;           // compressed contents, empty if stored raw
+		bool                m_valid;                // do m_raw/m_compressed match the last save or load?
+		bool                m_error;                // did the last operation fail?
+		osd_work_item *     m_item;                 // work item processing this chunk
+	};
+
 	// internal helpers
 	UINT32 signature() const;
+	void rewind_frame();
+	void build_chunks();
+	void process_chunks(osd_work_callback callback);
+	save_error read_legacy_file(emu_file &file, bool flip);
+	static void *compress_chunk(void *param, int threadid);
+	static void *decompress_chunk(void *param, int threadid);
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
@@ -186,6 +226,73 @@ private:
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
+
+	std::vector<std::unique_ptr<save_chunk>> m_chunks; // chunk layout of the serialized state
+	osd_work_queue *        m_chunk_queue;          // queue used to (de)compress chunks
+
+	std::unique_ptr<rewind_buffer> m_rewind;        // in-memory snapshot ring, if enabled
+	bool                    m_rewind_pending;       // has a frame completed since the last snapshot?
+};
+
+
+// ======================> rewind_buffer
+
+// in-memory ring of differential state snapshots
+class rewind_buffer
+{
+public:
+	// construction/destruction
+	rewind_buffer(save_manager &save, UINT32 capacity, UINT32 keyframe_interval, bool compress);
+
+	// getters
+	UINT32 count() const { return m_snapshots.size(); }
+	UINT32 capacity() const { return m_capacity; }
+	UINT64 bytes_used() const { return m_bytes_used; }
+
+	// snapshot control
+	void clear();
+	save_error capture();
+	save_error step_back(UINT32 frames);
+
+private:
+	// big entries are compared and stored in pieces of this size
+	static const UINT32 PAGE_SIZE = 4096;
+
+	// a piece of a single state entry
+	struct state_page
+	{
+		UINT8 *             m_data;                 // pointer to the live data
+		UINT32              m_length;               // length of this page
+		UINT32              m_base;                 // offset within the reference image
+	};
+
+	// a single captured snapshot
+	struct snapshot
+	{
+		bool                m_keyframe;             // does this hold every page?
+		bool                m_compressed;           // is m_data compressed?
+		UINT32              m_rawsize;              // size of the page contents before compression
+		std::vector<UINT32> m_pages;                // pages held by a delta snapshot
+		std::vector<UINT8>  m_data;                 // page contents, concatenated
+	};
+
+	// internal helpers
+	void build_page_table();
+	void pack(snapshot &snap, const std::vector<UINT8> &raw);
+	bool unpack(const snapshot &snap, std::vector<UINT8> &raw) const;
+	UINT32 oldest_group_size() const;
+	void evict();
+
+	// internal state
+	save_manager &          m_save;                 // reference to our owner
+	UINT32                  m_capacity;             // minimum number of snapshots kept once full
+	UINT32                  m_keyframe_interval;    // snapshots per keyframe
+	bool                    m_compress;             // compress snapshot contents?
+	UINT32                  m_group_size;           // snapshots captured since the last keyframe, inclusive
+	UINT64                  m_bytes_used;           // memory held by snapshot contents
+	std::vector<state_page> m_pages;                // page table over all entries
+	std::vector<UINT8>      m_reference;            // uncompressed image of the last keyframe
+	std::deque<snapshot>    m_snapshots;            // the ring itself, oldest first
 };
 
 
@@ -22,6 +22,15 @@
 
 
 
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// device executing on this thread as part of a parallel execute group
+thread_local device_execute_interface *device_scheduler::s_group_executing = nullptr;
+
+
+
 //**************************************************************************
 //  CONSTANTS
 //**************************************************************************
@@ -48,6 +57,8 @@ emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
 		m_prev(nullptr),
+		m_heapindex(-1),
+		m_sequence(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -81,6 +92,8 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heapindex = -1;
+	m_sequence = 0;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -97,6 +110,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 		register_save();
 
 	// insert into the list
+	device_scheduler::state_lock lock(machine.scheduler());
 	machine.scheduler().timer_list_insert(*this);
 	return *this;
 }
@@ -113,6 +127,8 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heapindex = -1;
+	m_sequence = 0;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -129,6 +145,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 		register_save();
 
 	// insert into the list
+	device_scheduler::state_lock lock(machine().scheduler());
 	machine().scheduler().timer_list_insert(*this);
 	return *this;
 }
@@ -142,6 +159,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 emu_timer &emu_timer::release()
 {
 	// unhook us from the global list
+	device_scheduler::state_lock lock(machine().scheduler());
 	machine().scheduler().timer_list_remove(*this);
 	return *this;
 }
@@ -154,15 +172,15 @@ emu_timer &emu_timer::release()
 bool emu_timer::enable(bool enable)
 {
 	// reschedule only if the state has changed
+	device_scheduler::state_lock lock(machine().scheduler());
 	bool old = m_enabled;
 	if (old != enable)
 	{
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// requeue the timer in its new order
+		machine().scheduler().timer_reschedule(*this);
 	}
 	return old;
 }
@@ -178,6 +196,7 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 {
 	// if this is the callback timer, mark it modified
 	device_scheduler &scheduler = machine().scheduler();
+	device_scheduler::state_lock lock(scheduler);
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
@@ -194,12 +213,11 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// requeue the timer in its new order
+	scheduler.timer_reschedule(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the next to fire, abort the current timeslice and resync
+	if (this == scheduler.next_timer())
 		scheduler.abort_timeslice();
 }
 
@@ -264,6 +282,7 @@ void emu_timer::register_save()
 	machine().save().save_item(m_device, "timer", name.c_str(), index, NAME(m_period));
 	machine().save().save_item(m_device, "timer", name.c_str(), index, NAME(m_start));
 	machine().save().save_item(m_device, "timer", name.c_str(), index, NAME(m_expire));
+	machine().save().save_item(m_device, "timer", name.c_str(), index, NAME(m_sequence));
 }
 
 
@@ -278,10 +297,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// requeue us in our new order
+	machine().scheduler().timer_reschedule(*this);
 }
 
 
@@ -315,18 +332,26 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
 	m_timer_list(nullptr),
+	m_timer_sequence(0),
+	m_timer_inserts(0),
+	m_timer_removes(0),
+	m_timer_updates(0),
+	m_timer_steps(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
+	m_group_queue(nullptr),
+	m_parallel(false),
+	m_main_done(false),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	// add a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
+	machine.save().save_item(NAME(m_timer_sequence));
 	machine.save().register_presave(save_prepost_delegate(FUNC(device_scheduler::presave), this));
 	machine.save().register_postload(save_prepost_delegate(FUNC(device_scheduler::postload), this));
 }
@@ -341,6 +366,10 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_timer_list != nullptr)
 		m_timer_allocator.reclaim(m_timer_list->release());
+
+	// free the group queue
+	if (m_group_queue != nullptr)
+		osd_work_queue_free(m_group_queue);
 }
 
 
@@ -356,7 +385,37 @@ attotime device_scheduler::time() const
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *exec = currently_executing();
+	return (exec != nullptr) ? exec->local_time() : m_basetime;
+}
+
+
+//-------------------------------------------------
+//  currently_executing - return the device
+//  executing on the calling thread, if any
+//-------------------------------------------------
+
+device_execute_interface *device_scheduler::currently_executing() const
+{
+	return (s_group_executing != nullptr) ? s_group_executing : m_executing_device;
+}
+
+
+//-------------------------------------------------
+//  crosses_execute_groups - return true if the
+//  given device may be running on another thread
+//  than the caller right now
+//-------------------------------------------------
+
+bool device_scheduler::crosses_execute_groups(device_t &device) const
+{
+	if (!m_parallel)
+		return false;
+
+	device_execute_interface *exec;
+	int group = device.interface(exec) ? exec->execute_group() : 0;
+	int current = (s_group_executing != nullptr) ? s_group_executing->execute_group() : 0;
+	return group != current;
 }
 
 
@@ -405,6 +464,116 @@ inline void device_scheduler::apply_suspend_changes()
 }
 
 
+//-------------------------------------------------
+//  execute_device - run a single device up to the
+//  target time, lowering the target if it stops
+//  early
+//-------------------------------------------------
+
+inline void device_scheduler::execute_device(device_execute_interface &exec, attotime &target, device_execute_interface *&executing, bool call_debugger)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec.m_suspend == 0 || exec.m_eatcycles) && target.seconds() >= exec.m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec.m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec.m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec.m_localtime).as_attoseconds());
+
+		// if we have enough for at least 1 cycle, do the math
+		if (delta >= exec.m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec.m_cycles_running = divu_64x32((UINT64)delta >> exec.m_divshift, exec.m_divisor);
+			LOG(("  cpu '%s': %d (%d cycles)\n", exec.device().tag(), delta, exec.m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (exec.m_suspend == 0)
+			{
+				if (&executing == &m_executing_device)
+					g_profiler.start(exec.m_profiler);
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec.m_cycles_stolen = 0;
+				executing = &exec;
+				*exec.m_icountptr = exec.m_cycles_running;
+				if (!call_debugger)
+					exec.run();
+				else
+				{
+					debugger_start_cpu_hook(&exec.device(), target);
+					exec.run();
+					debugger_stop_cpu_hook(&exec.device());
+				}
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec.m_icountptr);
+				ran -= *exec.m_icountptr;
+				assert(ran >= exec.m_cycles_stolen);
+				ran -= exec.m_cycles_stolen;
+				if (&executing == &m_executing_device)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec.m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime(0, exec.m_attoseconds_per_cycle * ran);
+			assert(deltatime >= attotime::zero);
+			exec.m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec.m_totalcycles, exec.m_localtime.as_string(PRECISION)));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec.m_localtime < target)
+			{
+				target = max(exec.m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_group_callback - run all the devices
+//  of one execute group on a worker thread
+//-------------------------------------------------
+
+void *device_scheduler::execute_group_callback(void *param, int threadid)
+{
+	execute_group &group = *reinterpret_cast<execute_group *>(param);
+	for (device_execute_interface *exec : group.m_devices)
+		group.m_scheduler->execute_device(*exec, group.m_target, s_group_executing, false);
+	s_group_executing = nullptr;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  group_sync::enter - wait for the main group
+//  to finish its timeslice, then take the state
+//  lock
+//-------------------------------------------------
+
+void device_scheduler::group_sync::enter()
+{
+	device_scheduler &scheduler = s_group_executing->scheduler();
+
+	// a group that ran inline on the main thread (no worker available) has nothing to wait for
+	if (std::this_thread::get_id() != scheduler.m_main_thread)
+	{
+		std::unique_lock<std::mutex> lock(scheduler.m_main_mutex);
+		scheduler.m_main_cond.wait(lock, [&scheduler] { return scheduler.m_main_done; });
+	}
+	scheduler.m_state_mutex.lock();
+	m_scheduler = &scheduler;
+}
+
+
 //-------------------------------------------------
 //  timeslice - execute all devices for a single
 //  timeslice
@@ -423,14 +592,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < next_timer()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (next_timer()->m_expire < target)
+			target = next_timer()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -439,70 +608,52 @@ void device_scheduler::timeslice()
 		if (m_suspend_changes_pending)
 			apply_suspend_changes();
 
-		// loop over all CPUs
-		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		// loop over all CPUs, serially unless some run in their own groups
+		if (m_groups.empty() || call_debugger)
+		{
+			for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+				execute_device(*exec, target, m_executing_device, call_debugger);
+		}
+		else
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+			// start each group on a worker thread with its own copy of the target
+			m_parallel = true;
+			m_main_done = false;
+			m_main_thread = std::this_thread::get_id();
+			for (auto &group : m_groups)
+			{
+				group->m_target = target;
+				group->m_item = osd_work_item_queue(m_group_queue, execute_group_callback, group.get(), 0);
+				if (group->m_item == nullptr)
+					execute_group_callback(group.get(), 0);
+			}
+
+			// run the main group here
+			for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+				if (exec->m_execute_group == 0)
+					execute_device(*exec, target, m_executing_device, false);
+
+			// release any group waiting to reach outside itself
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
-
-				// if we have enough for at least 1 cycle, do the math
-				if (delta >= exec->m_attoseconds_per_cycle)
+				std::lock_guard<std::mutex> lock(m_main_mutex);
+				m_main_done = true;
+			}
+			m_main_cond.notify_all();
+
+			// wait for the groups; whoever stopped earliest sets the new base time, and
+			// anyone who ran past it sits out until the others catch up
+			for (auto &group : m_groups)
+			{
+				if (group->m_item != nullptr)
 				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							debugger_start_cpu_hook(&exec->device(), target);
-							exec->run();
-							debugger_stop_cpu_hook(&exec->device());
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime(0, exec->m_attoseconds_per_cycle * ran);
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
-					}
+					while (!osd_work_item_wait(group->m_item, 100 * osd_ticks_per_second())) { }
+					osd_work_item_release(group->m_item);
+					group->m_item = nullptr;
 				}
+				if (group->m_target < target)
+					target = group->m_target;
 			}
+			m_parallel = false;
 		}
 		m_executing_device = nullptr;
 
@@ -522,8 +673,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *exec = currently_executing();
+	if (exec != nullptr)
+		exec->abort_timeslice();
 }
 
 
@@ -558,6 +710,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 	// ignore timeslices > 1 second
 	if (timeslice_time.seconds() > 0)
 		return;
+	state_lock lock(*this);
 	add_scheduling_quantum(timeslice_time, boost_duration);
 }
 
@@ -569,6 +722,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
+	state_lock lock(*this);
 	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
 }
 
@@ -581,6 +735,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
+	state_lock lock(*this);
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
@@ -593,6 +748,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegate callback, int param, void *ptr)
 {
+	state_lock lock(*this);
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, false).adjust(period, param, period);
 }
 
@@ -604,6 +760,7 @@ void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
+	state_lock lock(*this);
 	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
 }
 
@@ -616,6 +773,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
+	state_lock lock(*this);
 	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
 }
 
@@ -661,25 +819,29 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *next;
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = next)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		next = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
+	// the expiration times and sequence numbers of the permanent ones were just
+	// loaded, so rebuild the heap in place; timers due at the same time then
+	// fire in the same order they would have before the save
+	for (emu_timer *timer : m_timer_heap)
+		timer->m_heapindex = -1;
+	m_timer_heap.clear();
+	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
+		if (timer->m_enabled)
+		{
+			m_timer_heap.push_back(timer);
+			timer->m_heapindex = m_timer_heap.size() - 1;
+		}
+	for (UINT32 index = m_timer_heap.size() / 2; index-- > 0; )
+		timer_heap_sift_down(index);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -800,59 +962,129 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// the groups follow the same order
+	rebuild_execute_groups();
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  rebuild_execute_groups - collect devices that
+//  asked to run in their own execute group off
+//  the main thread
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+void device_scheduler::rebuild_execute_groups()
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	for (auto &group : m_groups)
+		group->m_devices.clear();
 
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
 	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
+		if (exec->m_execute_group == 0)
+			continue;
+
+		// find or create the group
+		auto found = std::find_if(m_groups.begin(), m_groups.end(), [exec](const std::unique_ptr<execute_group> &group) { return group->m_group == exec->m_execute_group; });
+		if (found == m_groups.end())
 		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
+			std::unique_ptr<execute_group> group = std::make_unique<execute_group>();
+			group->m_scheduler = this;
+			group->m_group = exec->m_execute_group;
+			group->m_item = nullptr;
+			found = m_groups.insert(m_groups.end(), std::move(group));
+		}
+		(*found)->m_devices.push_back(exec);
+	}
 
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+	// drop any groups left empty by suspensions
+	m_groups.erase(std::remove_if(m_groups.begin(), m_groups.end(), [](const std::unique_ptr<execute_group> &group) { return group->m_devices.empty(); }), m_groups.end());
+
+	// check the memory layout and allocate a queue the first time we need one
+	if (!m_groups.empty() && m_group_queue == nullptr)
+	{
+		check_execute_groups();
+		m_group_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	}
+}
+
+
+//-------------------------------------------------
+//  check_execute_groups - make sure devices in
+//  different groups don't map the same shared
+//  memory or banks, which they would otherwise
+//  access directly without any rendezvous; bank
+//  switches reaching across groups are caught by
+//  memory_bank when they happen
+//-------------------------------------------------
+
+void device_scheduler::check_execute_groups()
+{
+	std::unordered_map<std::string, int> owners;
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+	{
+		device_memory_interface *memory;
+		if (!exec->device().interface(memory))
+			continue;
 
-			curtimer->m_prev = &timer;
-			return timer;
+		// claim a share or bank for this device's group, failing if another group has it
+		auto claim = [&owners, exec](const std::string &tag)
+		{
+			auto result = owners.emplace(tag, exec->m_execute_group);
+			if (!result.second && result.first->second != exec->m_execute_group)
+				throw emu_fatalerror("Device '%s' in execute group %d maps '%s', which is also mapped in execute group %d\n", exec->device().tag(), exec->m_execute_group, tag.c_str(), result.first->second);
+		};
+
+		for (int spacenum = 0; spacenum < ADDRESS_SPACES; spacenum++)
+		{
+			if (!memory->has_space(spacenum) || memory->space(spacenum).map() == nullptr)
+				continue;
+			address_space &space = memory->space(spacenum);
+			for (address_map_entry &entry : space.map()->m_entrylist)
+			{
+				if (entry.m_share != nullptr)
+					claim(entry.m_devbase.subtag(entry.m_share));
+				if (entry.m_read.m_type == AMH_BANK && entry.m_read.m_tag != nullptr)
+					claim(space.device().siblingtag(entry.m_read.m_tag));
+				if (entry.m_write.m_type == AMH_BANK && entry.m_write.m_tag != nullptr)
+					claim(space.device().siblingtag(entry.m_write.m_tag));
+			}
 		}
 	}
+}
 
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
 
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
+//-------------------------------------------------
+//  timer_list_insert - add a new timer to the
+//  list of all timers, and queue it if it is
+//  enabled
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// the list is unordered, so just link in at the head
+	timer.m_prev = nullptr;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != nullptr)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// only enabled timers are queued
+	if (timer.m_enabled)
+		timer_heap_insert(timer);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the queue
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
+	timer_heap_remove(timer);
+
 	// remove it from the list
 	if (timer.m_prev != nullptr)
 		timer.m_prev->m_next = timer.m_next;
@@ -862,23 +1094,138 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != nullptr)
 		timer.m_next->m_prev = timer.m_prev;
 
+	timer.m_next = timer.m_prev = nullptr;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_reschedule - requeue a timer after its
+//  expiration time or enable state changed
+//-------------------------------------------------
+
+void device_scheduler::timer_reschedule(emu_timer &timer)
+{
+	// disabled timers leave the queue entirely
+	if (!timer.m_enabled)
+		timer_heap_remove(timer);
+
+	// new timers get queued
+	else if (timer.m_heapindex < 0)
+		timer_heap_insert(timer);
+
+	// queued ones move in place; the new sequence number puts them after any
+	// timer already due at the same time, as if they were inserted afresh
+	else
+	{
+		m_timer_updates++;
+		timer.m_sequence = m_timer_sequence++;
+		timer_heap_sift_up(timer.m_heapindex);
+		timer_heap_sift_down(timer.m_heapindex);
+	}
+}
+
+
+//-------------------------------------------------
+//  timer_heap_insert - add a timer to the heap
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_insert(emu_timer &timer)
+{
+	assert(timer.m_heapindex < 0);
+	m_timer_inserts++;
+	timer.m_sequence = m_timer_sequence++;
+	m_timer_heap.push_back(&timer);
+	timer.m_heapindex = m_timer_heap.size() - 1;
+	timer_heap_sift_up(timer.m_heapindex);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_remove - remove a timer from the
+//  heap, if it is there
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_remove(emu_timer &timer)
+{
+	if (timer.m_heapindex < 0)
+		return;
+	m_timer_removes++;
+
+	// move the last entry into the hole and let it find its level
+	UINT32 index = timer.m_heapindex;
+	emu_timer &last = *m_timer_heap.back();
+	m_timer_heap.pop_back();
+	timer.m_heapindex = -1;
+	if (&last != &timer)
+	{
+		timer_heap_place(last, index);
+		timer_heap_sift_up(index);
+		timer_heap_sift_down(last.m_heapindex);
+	}
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move an entry towards the
+//  root until its parent fires before it
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(UINT32 index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	while (index > 0)
+	{
+		UINT32 parent = (index - 1) / 2;
+		if (!timer_heap_before(timer, *m_timer_heap[parent]))
+			break;
+		timer_heap_place(*m_timer_heap[parent], index);
+		index = parent;
+		m_timer_steps++;
+	}
+	timer_heap_place(timer, index);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move an entry towards
+//  the leaves until both children fire after it
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(UINT32 index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	UINT32 count = m_timer_heap.size();
+	while (1)
+	{
+		UINT32 child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && timer_heap_before(*m_timer_heap[child + 1], *m_timer_heap[child]))
+			child++;
+		if (!timer_heap_before(*m_timer_heap[child], timer))
+			break;
+		timer_heap_place(*m_timer_heap[child], index);
+		index = child;
+		m_timer_steps++;
+	}
+	timer_heap_place(timer, index);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), next_timer()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (next_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *next_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -980,5 +1327,8 @@ void device_scheduler::dump_timers() const
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
 	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
 		timer->dump();
+	machine().logerror("Timer queue: %d queued, %d inserts, %d removes, %d updates, %.2f levels per operation\n",
+			int(m_timer_heap.size()), int(m_timer_inserts), int(m_timer_removes), int(m_timer_updates),
+			double(m_timer_steps) / double(MAX(m_timer_inserts + m_timer_removes + m_timer_updates, 1)));
 	machine().logerror("=============================================\n");
 }
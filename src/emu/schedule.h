@@ -17,6 +17,10 @@
 #ifndef __SCHEDULE_H__
 #define __SCHEDULE_H__
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 //**************************************************************************
 //  MACROS
@@ -94,8 +98,10 @@ private:
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	INT32               m_heapindex;    // index in the scheduler's heap, or -1 if not queued
+	UINT64              m_sequence;     // insertion order, to keep equal expirations first-in first-out
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -125,7 +131,9 @@ public:
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
 	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	emu_timer *next_timer() const { return m_timer_heap.front(); }
+	device_execute_interface *currently_executing() const;
+	bool crosses_execute_groups(device_t &device) const;
 	bool can_save() const;
 
 	// execution
@@ -159,7 +167,50 @@ public:
 	// for emergencies only!
 	void eat_all_cycles();
 
+	// ======================> state_lock
+
+	// held around changes to shared scheduler state; only takes the lock while
+	// execute groups are running in parallel
+	class state_lock
+	{
+	public:
+		state_lock(const device_scheduler &scheduler) : m_mutex(scheduler.m_parallel ? &scheduler.m_state_mutex : nullptr) { if (m_mutex != nullptr) m_mutex->lock(); }
+		~state_lock() { if (m_mutex != nullptr) m_mutex->unlock(); }
+
+	private:
+		std::recursive_mutex *  m_mutex;
+	};
+
+	// ======================> group_sync
+
+	// held around anything a device in an execute group does that can reach
+	// outside its group (memory handlers, callbacks, interrupt acknowledges);
+	// on a worker thread it waits for the main group to finish the timeslice,
+	// then holds the state lock, so such accesses see the main group as a
+	// serial run would; the main thread never waits
+	class group_sync
+	{
+	public:
+		group_sync() : m_scheduler(nullptr) { if (UNEXPECTED(s_group_executing != nullptr)) enter(); }
+		~group_sync() { if (m_scheduler != nullptr) m_scheduler->m_state_mutex.unlock(); }
+
+	private:
+		void enter();
+
+		device_scheduler *      m_scheduler;
+	};
+
 private:
+	// an execute group runs its devices on a worker thread alongside the main thread
+	struct execute_group
+	{
+		device_scheduler *                      m_scheduler;    // owning scheduler
+		int                                     m_group;        // group number
+		std::vector<device_execute_interface *> m_devices;      // devices in execution order
+		attotime                                m_target;       // target time; lowered if a device stops early
+		osd_work_item *                         m_item;         // work item while running
+	};
+
 	// callbacks
 	void timed_trigger(void *ptr, INT32 param);
 	void presave();
@@ -168,30 +219,62 @@ private:
 	// scheduling helpers
 	void compute_perfect_interleave();
 	void rebuild_execute_list();
+	void rebuild_execute_groups();
+	void check_execute_groups();
+	void execute_device(device_execute_interface &exec, attotime &target, device_execute_interface *&executing, bool call_debugger);
+	static void *execute_group_callback(void *param, int threadid);
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
 
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_reschedule(emu_timer &timer);
 	void execute_timers();
 
+	// timer heap helpers
+	static bool timer_heap_before(const emu_timer &timer1, const emu_timer &timer2) { return (timer1.m_expire < timer2.m_expire) || (timer1.m_expire == timer2.m_expire && timer1.m_sequence < timer2.m_sequence); }
+	void timer_heap_insert(emu_timer &timer);
+	void timer_heap_remove(emu_timer &timer);
+	void timer_heap_sift_up(UINT32 index);
+	void timer_heap_sift_down(UINT32 index);
+	void timer_heap_place(emu_timer &timer, UINT32 index) { m_timer_heap[index] = &timer; timer.m_heapindex = index; }
+
 	// internal state
 	running_machine &           m_machine;                  // reference to our machine
 	device_execute_interface *  m_executing_device;         // pointer to currently executing device
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// timers: an unordered list of all of them, plus a min-heap of the enabled ones by expiration
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	std::vector<emu_timer *>    m_timer_heap;               // binary heap of enabled timers
+	UINT64                      m_timer_sequence;           // next insertion sequence number
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
+	// timer queue statistics, reported by dump_timers
+	UINT64                      m_timer_inserts;            // number of heap insertions
+	UINT64                      m_timer_removes;            // number of heap removals
+	UINT64                      m_timer_updates;            // number of in-place reschedules
+	UINT64                      m_timer_steps;              // number of heap levels traversed
+
 	// other internal states
 	emu_timer *                 m_callback_timer;           // pointer to the current callback timer
 	bool                        m_callback_timer_modified;  // true if the current callback timer was modified
 	attotime                    m_callback_timer_expire_time; // the original expiration time
 	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
 
+	// parallel execute groups
+	std::vector<std::unique_ptr<execute_group>> m_groups;   // groups other than the main one
+	osd_work_queue *            m_group_queue;              // queue for running groups
+	bool                        m_parallel;                 // are groups running right now?
+	mutable std::recursive_mutex m_state_mutex;             // protects shared state while they are
+	bool                        m_main_done;                // has the main group finished this timeslice?
+	std::mutex                  m_main_mutex;               // protects m_main_done
+	std::condition_variable     m_main_cond;                // signalled when m_main_done is set
+	std::thread::id             m_main_thread;              // thread running the main group
+	static thread_local device_execute_interface *s_group_executing; // device executing on this worker thread
+
 	// scheduling quanta
 	class quantum_slot
 	{
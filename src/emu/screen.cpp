@@ -318,6 +318,11 @@ void screen_device::device_start()
 	m_texture[1] = machine().render().texture_alloc();
 	m_texture[1]->set_osd_data((UINT64)((m_unique_id << 1) | 1));
 
+	// we report changes to the textures ourselves
+	m_texture[0]->set_dirty_tracking(true);
+	m_texture[1]->set_dirty_tracking(true);
+	m_flip_dirty.set(0, -1, 0, -1);
+
 	// configure the default cliparea
 	render_container::user_settings settings;
 	m_container->get_user_settings(settings);
@@ -1007,9 +1012,22 @@ bool screen_device::update_quads()
 			// if we're not skipping the frame and if the screen actually changed, then update the texture
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
-				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
-				m_curtexture = m_curbitmap;
-				m_curbitmap = 1 - m_curbitmap;
+				// find out what differs from the frame on display; if nothing does, keep
+				// showing it and render the next frame into the same bitmap again
+				rectangle dirty = (m_curbitmap == m_curtexture) ? m_visarea : changed_area(m_bitmap[m_curbitmap], m_bitmap[m_curtexture]);
+				if (!dirty.empty())
+				{
+					// the new texture last held the frame before the one on display, so it
+					// also needs whatever changed between those two
+					rectangle texdirty = dirty;
+					if (!m_flip_dirty.empty())
+						texdirty |= m_flip_dirty;
+					m_texture[m_curbitmap]->mark_dirty(texdirty);
+					m_flip_dirty = dirty;
+
+					m_curtexture = m_curbitmap;
+					m_curbitmap = 1 - m_curbitmap;
+				}
 			}
 
 			// brightness adjusted render color
@@ -1028,6 +1046,31 @@ bool screen_device::update_quads()
 }
 
 
+//-------------------------------------------------
+//  changed_area - return the band of visible
+//  rows that differ between two screen bitmaps
+//-------------------------------------------------
+
+rectangle screen_device::changed_area(screen_bitmap &newbitmap, screen_bitmap &oldbitmap) const
+{
+	bitmap_t &newlive = newbitmap;
+	bitmap_t &oldlive = oldbitmap;
+	int bytes = m_visarea.width() * newlive.bpp() / 8;
+
+	// scan in from the top and the bottom
+	int miny, maxy;
+	for (miny = m_visarea.min_y; miny <= m_visarea.max_y; miny++)
+		if (memcmp(newlive.raw_pixptr(miny, m_visarea.min_x), oldlive.raw_pixptr(miny, m_visarea.min_x), bytes) != 0)
+			break;
+	if (miny > m_visarea.max_y)
+		return rectangle(0, -1, 0, -1);
+	for (maxy = m_visarea.max_y; maxy > miny; maxy--)
+		if (memcmp(newlive.raw_pixptr(maxy, m_visarea.min_x), oldlive.raw_pixptr(maxy, m_visarea.min_x), bytes) != 0)
+			break;
+	return rectangle(m_visarea.min_x, m_visarea.max_x, miny, maxy);
+}
+
+
 //-------------------------------------------------
 //  update_burnin - update the burnin bitmap
 //-------------------------------------------------
@@ -235,6 +235,7 @@ public:
 
 	// internal to the video system
 	bool update_quads();
+	rectangle changed_area(screen_bitmap &newbitmap, screen_bitmap &oldbitmap) const;
 	void update_burnin();
 
 	// globally accessible constants
@@ -296,6 +297,7 @@ private:
 	bitmap_ind64        m_burnin;                   // burn-in bitmap
 	UINT8               m_curbitmap;                // current bitmap index
 	UINT8               m_curtexture;               // current texture index
+	rectangle           m_flip_dirty;               // area that differed at the last texture flip
 	bool                m_changed;                  // has this bitmap changed?
 	INT32               m_last_partial_scan;        // scanline of last partial update
 	INT32               m_partial_scan_hpos;        // horizontal pixel last rendered on this partial scanline
@@ -14,6 +14,13 @@
 #include "config.h"
 #include "sound/wavwrite.h"
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define SOUND_USE_SSE2  (1)
+#include <emmintrin.h>
+#else
+#define SOUND_USE_SSE2  (0)
+#endif
+
 
 
 //**************************************************************************
@@ -38,6 +45,51 @@
 
 const attotime sound_manager::STREAMS_UPDATE_ATTOTIME = attotime::from_hz(STREAMS_UPDATE_FREQUENCY);
 
+// set while a worker thread updates a stream whose inputs are known to be current
+static thread_local bool s_graph_worker = false;
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_dot - apply one phase of a polyphase
+//  filter to a run of FILTER_TAPS source samples
+//-------------------------------------------------
+
+static inline float resample_dot(const stream_sample_t *source, const float *coeffs)
+{
+#if SOUND_USE_SSE2
+	__m128 sum0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[0])), _mm_loadu_ps(&coeffs[0]));
+	__m128 sum1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[4])), _mm_loadu_ps(&coeffs[4]));
+	sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[8])), _mm_loadu_ps(&coeffs[8])));
+	sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[12])), _mm_loadu_ps(&coeffs[12])));
+	sum0 = _mm_add_ps(sum0, sum1);
+	sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+	sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+	return _mm_cvtss_f32(sum0);
+#else
+	float sum = 0;
+	for (int tap = 0; tap < 16; tap++)
+		sum += float(source[tap]) * coeffs[tap];
+	return sum;
+#endif
+}
+
+
+//-------------------------------------------------
+//  resample_round - convert a float sample back
+//  to the stream's integer format
+//-------------------------------------------------
+
+static inline stream_sample_t resample_round(float sample)
+{
+	// round to nearest; the range is well within INT32
+	return (sample >= 0) ? stream_sample_t(sample + 0.5f) : -stream_sample_t(0.5f - sample);
+}
+
 
 
 //**************************************************************************
@@ -64,7 +116,8 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_output_sampindex(0),
 		m_output_update_sampindex(0),
 		m_output_base_sampindex(0),
-		m_callback(std::move(callback))
+		m_callback(std::move(callback)),
+		m_graph_level(-1)
 {
 	// get the device's sound interface
 	device_sound_interface *sound;
@@ -251,6 +304,9 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	if (input.m_source != nullptr)
 		input.m_source->m_dependents++;
 
+	// the graph changed shape
+	m_device.machine().sound().m_graph_dirty = true;
+
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
 }
@@ -282,12 +338,15 @@ void sound_stream::update()
 		update_sampindex -= m_sample_rate;
 	}
 
-	// generate samples to get us up to the appropriate time
-	g_profiler.start(PROFILER_SOUND);
+	// generate samples to get us up to the appropriate time; the profiler is
+	// not thread safe, so leave it to the main thread
+	if (!s_graph_worker)
+		g_profiler.start(PROFILER_SOUND);
 	assert(m_output_sampindex - m_output_base_sampindex >= 0);
 	assert(update_sampindex - m_output_base_sampindex <= m_output_bufalloc);
 	generate_samples(update_sampindex - m_output_sampindex);
-	g_profiler.stop();
+	if (!s_graph_worker)
+		g_profiler.stop();
 
 	// remember this info for next time
 	m_output_sampindex = update_sampindex;
@@ -609,9 +668,10 @@ void sound_stream::generate_samples(int samples)
 	// ensure all inputs are up to date and generate resampled data
 	for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
 	{
-		// update the stream to the current time
+		// update the stream to the current time; graph workers only run once
+		// everything upstream is done, and must not touch shared streams
 		stream_input &input = m_input[inputnum];
-		if (input.m_source != nullptr)
+		if (input.m_source != nullptr && !s_graph_worker)
 			input.m_source->m_stream->update();
 
 		// generate the resampled data
@@ -696,6 +756,29 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 		}
 	}
 
+	// up to 2:1 either way, use the band-limited polyphase filter; it looks back
+	// FILTER_TAPS - 2 samples and ahead by one, so we need that much history
+	else if (step < 2 * FRAC_ONE && basesample - (FILTER_TAPS - 2) >= input_stream.m_output_base_sampindex)
+	{
+		if (input.m_filter_step != step)
+			build_resample_filter(input, step);
+
+		// fold the gain into the filtered sample; this matches the >> 8 above
+		const float *filter = &input.m_filter[0];
+		float fgain = float(gain) * (1.0f / 256.0f);
+		source -= FILTER_TAPS - 2;
+		while (numsamples--)
+		{
+			const float *coeffs = &filter[(basefrac >> (FRAC_BITS - FILTER_PHASE_BITS)) * FILTER_TAPS];
+			*dest++ = resample_round(resample_dot(source, coeffs) * fgain);
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+
 	// input is undersampled: point sample except where our sample period covers a boundary
 	else if (step < FRAC_ONE)
 	{
@@ -762,6 +845,67 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 }
 
 
+//-------------------------------------------------
+//  build_resample_filter - compute the windowed
+//  sinc polyphase filter for a given step; the
+//  output is delayed by FILTER_TAPS / 2 - 1 input
+//  samples so the filter can stay causal
+//-------------------------------------------------
+
+void sound_stream::build_resample_filter(stream_input &input, UINT32 step)
+{
+	static_assert(FILTER_TAPS == 16, "resample_dot assumes 16 taps");
+
+	// when upsampling we keep the whole input band; when downsampling we have to
+	// cut at the output's Nyquist frequency instead; leave room for the transition
+	double cutoff = 0.92 * MIN(1.0, double(FRAC_ONE) / double(step));
+
+	input.m_filter.resize(FILTER_PHASES * FILTER_TAPS);
+	for (int phase = 0; phase < FILTER_PHASES; phase++)
+	{
+		float *coeffs = &input.m_filter[phase * FILTER_TAPS];
+		double frac = double(phase) / double(FILTER_PHASES);
+		double total = 0;
+		for (int tap = 0; tap < FILTER_TAPS; tap++)
+		{
+			// distance from this tap to the delayed output position, in input samples
+			double dist = frac + (FILTER_TAPS / 2 - 1) - tap;
+			double x = M_PI * cutoff * dist;
+			double sinc = (x == 0) ? 1.0 : sin(x) / x;
+			double window = 0.42 + 0.5 * cos(M_PI * dist / (FILTER_TAPS / 2)) + 0.08 * cos(2 * M_PI * dist / (FILTER_TAPS / 2));
+			coeffs[tap] = sinc * window;
+			total += coeffs[tap];
+		}
+
+		// normalize each phase to unity gain at DC
+		for (int tap = 0; tap < FILTER_TAPS; tap++)
+			coeffs[tap] /= total;
+	}
+	input.m_filter_step = step;
+}
+
+
+//-------------------------------------------------
+//  compute_graph_level - return the length of the
+//  longest chain of streams feeding this one
+//-------------------------------------------------
+
+int sound_stream::compute_graph_level()
+{
+	if (m_graph_level >= 0)
+		return m_graph_level;
+
+	// mark ourself as a source while we recurse, in case of a loop
+	m_graph_level = 0;
+	int level = 0;
+	for (auto &input : m_input)
+		if (input.m_source != nullptr && input.m_source->m_stream != this)
+			level = MAX(level, input.m_source->m_stream->compute_graph_level() + 1);
+	m_graph_level = level;
+	return level;
+}
+
+
 
 //**************************************************************************
 //  STREAM INPUT
@@ -773,6 +917,7 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 
 sound_stream::stream_input::stream_input()
 	: m_source(nullptr),
+		m_filter_step(0),
 		m_latency_attoseconds(0),
 		m_gain(0x100),
 		m_user_gain(0x100)
@@ -818,7 +963,9 @@ sound_manager::sound_manager(running_machine &machine)
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
-		m_last_update(attotime::zero)
+		m_last_update(attotime::zero),
+		m_graph_dirty(true),
+		m_graph_queue(nullptr)
 {
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
@@ -853,6 +1000,10 @@ sound_manager::sound_manager(running_machine &machine)
 	// start the periodic update flushing timer
 	m_update_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(sound_manager::update), this));
 	m_update_timer->adjust(STREAMS_UPDATE_ATTOTIME, 0, STREAMS_UPDATE_ATTOTIME);
+
+	// allocate a queue if we are allowed to update streams in parallel
+	if (machine.options().sound_parallel())
+		m_graph_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 }
 
 
@@ -866,6 +1017,10 @@ sound_manager::~sound_manager()
 	if (m_wavfile != nullptr)
 		wav_close(m_wavfile);
 	m_wavfile = nullptr;
+
+	// free the update queue
+	if (m_graph_queue != nullptr)
+		osd_work_queue_free(m_graph_queue);
 }
 
 
@@ -875,6 +1030,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
+	m_graph_dirty = true;
 	return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, callback)));
 }
 
@@ -1037,6 +1193,9 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring every stream up to date in dependency order
+	update_graph();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	speaker_device_iterator iter(machine().root_device());
@@ -1047,8 +1206,25 @@ void sound_manager::update(void *ptr, int param)
 	UINT32 finalmix_step = machine().video().speed_factor();
 	UINT32 finalmix_offset = 0;
 	INT16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+	int sample = m_finalmix_leftover;
+
+#if SOUND_USE_SSE2
+	// at normal speed, interleave and saturate four stereo samples at a time
+	if (finalmix_step == 1000 && sample == 0)
+	{
+		for ( ; sample + 4000 <= samples_this_update * 1000; sample += 4000)
+		{
+			int sampindex = sample / 1000;
+			__m128i left = _mm_loadu_si128((const __m128i *)&m_leftmix[sampindex]);
+			__m128i right = _mm_loadu_si128((const __m128i *)&m_rightmix[sampindex]);
+			__m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(left, right), _mm_unpackhi_epi32(left, right));
+			_mm_storeu_si128((__m128i *)&finalmix[finalmix_offset], packed);
+			finalmix_offset += 8;
+		}
+	}
+#endif
+
+	for ( ; sample < samples_this_update * 1000; sample += finalmix_step)
 	{
 		int sampindex = sample / 1000;
 
@@ -1102,3 +1278,70 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  rebuild_graph - sort the streams into levels,
+//  so that each stream only depends on streams
+//  in earlier levels
+//-------------------------------------------------
+
+void sound_manager::rebuild_graph()
+{
+	for (sound_stream &stream : m_stream_list)
+		stream.m_graph_level = -1;
+
+	m_graph_levels.clear();
+	for (sound_stream &stream : m_stream_list)
+	{
+		int level = stream.compute_graph_level();
+		if (level >= int(m_graph_levels.size()))
+			m_graph_levels.resize(level + 1);
+		m_graph_levels[level].push_back(&stream);
+	}
+	m_graph_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  update_graph - update all streams level by
+//  level, running the streams within a level in
+//  parallel
+//-------------------------------------------------
+
+void sound_manager::update_graph()
+{
+	// without a queue, the speakers pull everything in on demand
+	if (m_graph_queue == nullptr)
+		return;
+
+	if (m_graph_dirty)
+		rebuild_graph();
+
+	for (auto &level : m_graph_levels)
+	{
+		// not worth handing off a single stream
+		if (level.size() == 1)
+			level[0]->update();
+		else
+		{
+			osd_work_item_queue_multiple(m_graph_queue, update_stream_callback, level.size(), &level[0], sizeof(level[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(m_graph_queue, 100 * osd_ticks_per_second())) { }
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  update_stream_callback - update one stream on
+//  a worker thread
+//-------------------------------------------------
+
+void *sound_manager::update_stream_callback(void *param, int threadid)
+{
+	sound_stream *stream = *reinterpret_cast<sound_stream **>(param);
+	s_graph_worker = true;
+	stream->update();
+	s_graph_worker = false;
+	return nullptr;
+}
@@ -83,6 +83,8 @@ class sound_stream
 		// internal state
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
+		std::vector<float>  m_filter;               // polyphase resampling filter, FILTER_PHASES x FILTER_TAPS
+		UINT32              m_filter_step;          // step the filter was built for (0 = none)
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
@@ -93,6 +95,9 @@ class sound_stream
 	static const UINT32 FRAC_BITS               = 22;
 	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
 	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
+	static const int FILTER_TAPS                = 16;
+	static const int FILTER_PHASE_BITS          = 8;
+	static const int FILTER_PHASES              = 1 << FILTER_PHASE_BITS;
 
 	// construction/destruction
 	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback);
@@ -136,6 +141,8 @@ private:
 	void postload();
 	void generate_samples(int samples);
 	stream_sample_t *generate_resampled_data(stream_input &input, UINT32 numsamples);
+	int compute_graph_level();
+	static void build_resample_filter(stream_input &input, UINT32 step);
 	void sync_update(void *, INT32);
 
 	// linking information
@@ -171,6 +178,9 @@ private:
 
 	// callback information
 	stream_update_delegate  m_callback;                   // callback function
+
+	// dependency graph information
+	int                 m_graph_level;                // longest path from a source stream (-1 = unknown)
 };
 
 
@@ -226,6 +236,9 @@ private:
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
 	void update(void *ptr = nullptr, INT32 param = 0);
+	void rebuild_graph();
+	void update_graph();
+	static void *update_stream_callback(void *param, int threadid);
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -246,6 +259,11 @@ private:
 	simple_list<sound_stream> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
+
+	// dependency graph
+	std::vector<std::vector<sound_stream *>> m_graph_levels; // streams grouped by graph level
+	bool                m_graph_dirty;          // must the graph be rebuilt?
+	osd_work_queue *    m_graph_queue;          // queue for parallel stream updates
 };
 
 
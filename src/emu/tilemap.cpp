@@ -10,6 +10,13 @@
 
 #include "emu.h"
 
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define TILEMAP_USE_SSE2    (1)
+#include <emmintrin.h>
+#else
+#define TILEMAP_USE_SSE2    (0)
+#endif
+
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -95,10 +102,84 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
+//**************************************************************************
+//  SSE2 HELPERS
+//**************************************************************************
+
+#if TILEMAP_USE_SSE2
+
+//-------------------------------------------------
+//  sse2_mask_match - return 0xff in each of 16
+//  bytes whose flags match the mask/value pair
+//-------------------------------------------------
+
+static inline __m128i sse2_mask_match(const UINT8 *maskptr, __m128i mask, __m128i value)
+{
+	return _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i *)maskptr), mask), value);
+}
+
+
+//-------------------------------------------------
+//  sse2_select - pick bits from a where select
+//  is set and from b elsewhere
+//-------------------------------------------------
+
+static inline __m128i sse2_select(__m128i select, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(select, a), _mm_andnot_si128(select, b));
+}
+
+
+//-------------------------------------------------
+//  sse2_priority - update 16 priority bytes,
+//  limited to the bytes set in select
+//-------------------------------------------------
+
+static inline void sse2_priority(UINT8 *pri, __m128i pand, __m128i por, __m128i select)
+{
+	__m128i old = _mm_loadu_si128((const __m128i *)pri);
+	__m128i upd = _mm_or_si128(_mm_and_si128(old, pand), por);
+	_mm_storeu_si128((__m128i *)pri, sse2_select(select, upd, old));
+}
+
+
+//-------------------------------------------------
+//  sse2_lookup4 - look up 4 source pixels in a
+//  color table
+//-------------------------------------------------
+
+static inline __m128i sse2_lookup4(const UINT16 *source, const rgb_t *clut)
+{
+	return _mm_set_epi32(clut[source[3]], clut[source[2]], clut[source[1]], clut[source[0]]);
+}
+
+
+//-------------------------------------------------
+//  sse2_alpha_blend4 - blend 4 pixels exactly as
+//  alpha_blend_r32 does
+//-------------------------------------------------
+
+static inline __m128i sse2_alpha_blend4(__m128i d, __m128i s, __m128i level, __m128i alphad)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), alphad));
+	__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), level), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), alphad));
+	__m128i result = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+	return _mm_and_si128(result, _mm_set1_epi32(0x00ffffff));
+}
+
+#endif
+
+
+
 //**************************************************************************
 //  SCANLINE RASTERIZERS
 //**************************************************************************
 
+// The rasterizers below process 16 pixels at a time with SSE2 where available
+// and fall back to the plain loops for the remainder; the results are the
+// same either way.
+
 //-------------------------------------------------
 //  scanline_draw_opaque_null - draw to a NULL
 //  bitmap, setting priority only
@@ -111,7 +192,13 @@ inline void tilemap_t::scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 p
 		return;
 
 	// update priority across the scanline
-	for (int i = 0; i < count; i++)
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i pand = _mm_set1_epi8(pcode >> 8), por = _mm_set1_epi8(pcode);
+	for ( ; i + 16 <= count; i += 16)
+		_mm_storeu_si128((__m128i *)&pri[i], _mm_or_si128(_mm_and_si128(_mm_loadu_si128((const __m128i *)&pri[i]), pand), por));
+#endif
+	for ( ; i < count; i++)
 		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 }
 
@@ -128,7 +215,14 @@ inline void tilemap_t::scanline_draw_masked_null(const UINT8 *maskptr, int mask,
 		return;
 
 	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i pand = _mm_set1_epi8(pcode >> 8), por = _mm_set1_epi8(pcode);
+	__m128i vmask = _mm_set1_epi8(mask), vvalue = _mm_set1_epi8(value);
+	for ( ; i + 16 <= count; i += 16)
+		sse2_priority(&pri[i], pand, por, sse2_mask_match(&maskptr[i], vmask, vvalue));
+#endif
+	for ( ; i < count; i++)
 		if ((maskptr[i] & mask) == value)
 			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
 }
@@ -149,31 +243,23 @@ inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *so
 		// use memcpy which should be well-optimized for the platform
 		memcpy(dest, source, count * 2);
 
-		// skip the rest if not changing priority
-		if (pcode == 0xff00)
-			return;
-
-		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		// skip the rest if not changing priority, otherwise update it
+		scanline_draw_opaque_null(count, pri, pcode);
+		return;
 	}
 
-	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i vpal = _mm_set1_epi16(pal);
+	for ( ; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i]), vpal));
+#endif
+	for ( ; i < count; i++)
+		dest[i] = source[i] + pal;
 
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+		scanline_draw_opaque_null(count, pri, pcode);
 }
 
 
@@ -185,11 +271,33 @@ inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *so
 inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
 {
 	int pal = pcode >> 16;
+	bool dopri = ((pcode & 0xffff) != 0xff00);
+
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i pand = _mm_set1_epi8(pcode >> 8), por = _mm_set1_epi8(pcode);
+	__m128i vmask = _mm_set1_epi8(mask), vvalue = _mm_set1_epi8(value);
+	__m128i vpal = _mm_set1_epi16(pal);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i select = sse2_mask_match(&maskptr[i], vmask, vvalue);
+
+		// widen the byte selects to cover two groups of 8 pixels
+		__m128i sello = _mm_unpacklo_epi8(select, select);
+		__m128i selhi = _mm_unpackhi_epi8(select, select);
+		__m128i srclo = _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i]), vpal);
+		__m128i srchi = _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i + 8]), vpal);
+		_mm_storeu_si128((__m128i *)&dest[i], sse2_select(sello, srclo, _mm_loadu_si128((const __m128i *)&dest[i])));
+		_mm_storeu_si128((__m128i *)&dest[i + 8], sse2_select(selhi, srchi, _mm_loadu_si128((const __m128i *)&dest[i + 8])));
+		if (dopri)
+			sse2_priority(&pri[i], pand, por, select);
+	}
+#endif
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (dopri)
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = source[i] + pal;
@@ -200,7 +308,7 @@ inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *so
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = source[i] + pal;
 	}
@@ -217,22 +325,13 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *so
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
+	// the lookups themselves have no vector form; the priority pass does
+	for (int i = 0; i < count; i++)
+		dest[i] = clut[source[i]];
+
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
+		scanline_draw_opaque_null(count, pri, pcode);
 }
 
 
@@ -244,11 +343,40 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *so
 inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
+	bool dopri = ((pcode & 0xffff) != 0xff00);
+
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i pand = _mm_set1_epi8(pcode >> 8), por = _mm_set1_epi8(pcode);
+	__m128i vmask = _mm_set1_epi8(mask), vvalue = _mm_set1_epi8(value);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i select = sse2_mask_match(&maskptr[i], vmask, vvalue);
+		int bits = _mm_movemask_epi8(select);
+
+		// skip fully transparent groups, and copy fully opaque ones straight through
+		if (bits == 0)
+			continue;
+		if (bits == 0xffff)
+		{
+			for (int j = i; j < i + 16; j++)
+				dest[j] = clut[source[j]];
+		}
+		else
+		{
+			for (int j = i; bits != 0; j++, bits >>= 1)
+				if (bits & 1)
+					dest[j] = clut[source[j]];
+		}
+		if (dopri)
+			sse2_priority(&pri[i], pand, por, select);
+	}
+#endif
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (dopri)
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = clut[source[i]];
@@ -259,7 +387,7 @@ inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *so
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = clut[source[i]];
 	}
@@ -275,22 +403,21 @@ inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT
 {
 	const rgb_t *clut = &pens[pcode >> 16];
 
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i level = _mm_set1_epi16(alpha), alphad = _mm_set1_epi16(256 - alpha);
+	for ( ; i + 4 <= count; i += 4)
 	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
+		__m128i d = _mm_loadu_si128((const __m128i *)&dest[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], sse2_alpha_blend4(d, sse2_lookup4(&source[i], clut), level, alphad));
 	}
+#endif
+	for ( ; i < count; i++)
+		dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
 
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
+	// priority case
+	if ((pcode & 0xffff) != 0xff00)
+		scanline_draw_opaque_null(count, pri, pcode);
 }
 
 
@@ -303,11 +430,41 @@ inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT
 inline void tilemap_t::scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const rgb_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
 {
 	const rgb_t *clut = &pens[pcode >> 16];
+	bool dopri = ((pcode & 0xffff) != 0xff00);
+
+	int i = 0;
+#if TILEMAP_USE_SSE2
+	__m128i pand = _mm_set1_epi8(pcode >> 8), por = _mm_set1_epi8(pcode);
+	__m128i vmask = _mm_set1_epi8(mask), vvalue = _mm_set1_epi8(value);
+	__m128i level = _mm_set1_epi16(alpha), alphad = _mm_set1_epi16(256 - alpha);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i select = sse2_mask_match(&maskptr[i], vmask, vvalue);
+		if (_mm_movemask_epi8(select) == 0)
+			continue;
+
+		// widen the byte selects to one dword per pixel, 4 pixels at a time
+		__m128i sel16lo = _mm_unpacklo_epi8(select, select);
+		__m128i sel16hi = _mm_unpackhi_epi8(select, select);
+		__m128i sel32[4] = { _mm_unpacklo_epi16(sel16lo, sel16lo), _mm_unpackhi_epi16(sel16lo, sel16lo), _mm_unpacklo_epi16(sel16hi, sel16hi), _mm_unpackhi_epi16(sel16hi, sel16hi) };
+		for (int group = 0; group < 4; group++)
+		{
+			if (_mm_movemask_epi8(sel32[group]) == 0)
+				continue;
+			int j = i + group * 4;
+			__m128i d = _mm_loadu_si128((const __m128i *)&dest[j]);
+			__m128i blended = sse2_alpha_blend4(d, sse2_lookup4(&source[j], clut), level, alphad);
+			_mm_storeu_si128((__m128i *)&dest[j], sse2_select(sel32[group], blended, d));
+		}
+		if (dopri)
+			sse2_priority(&pri[i], pand, por, select);
+	}
+#endif
 
 	// priority case
-	if ((pcode & 0xffff) != 0xff00)
+	if (dopri)
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
@@ -318,7 +475,7 @@ inline void tilemap_t::scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
 	}
@@ -969,6 +1126,12 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	{
 		const rectangle original_cliprect = blit.cliprect;
 
+		// resolve the row scroll values once; they are shared by every wraparound
+		// instance, and rows that match are merged into one span below
+		m_rowscroll_effective.resize(m_scrollrows);
+		for (UINT32 row = 0; row < m_scrollrows; row++)
+			m_rowscroll_effective[row] = effective_rowscroll(row, width);
+
 		// iterate over Y to handle wraparound
 		int rowheight = m_height / m_scrollrows;
 		int scrolly = effective_colscroll(0, height);
@@ -982,9 +1145,9 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			for (int currow = firstrow; currow <= lastrow; currow = nextrow)
 			{
 				// scan forward until we find a non-matching row
-				int scrollx = effective_rowscroll(currow, width);
+				int scrollx = m_rowscroll_effective[currow];
 				for (nextrow = currow + 1; nextrow <= lastrow; nextrow++)
-					if (effective_rowscroll(nextrow, width) != scrollx)
+					if (m_rowscroll_effective[nextrow] != scrollx)
 						break;
 
 				// skip if disabled
@@ -661,6 +661,7 @@ private:
 	UINT32                      m_scrollcols;           // number of independently scrolled columns
 	std::vector<INT32>               m_rowscroll;            // array of rowscroll values
 	std::vector<INT32>               m_colscroll;            // array of colscroll values
+	std::vector<INT32>               m_rowscroll_effective;  // effective rowscroll values during a draw
 	INT32                       m_dx;                   // global horizontal scroll offset
 	INT32                       m_dx_flipped;           // global horizontal scroll offset when flipped
 	INT32                       m_dy;                   // global vertical scroll offset
@@ -14,6 +14,24 @@
 #include <ctype.h>
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// number of drivers each worker checks at a time when validating in parallel
+const int VALIDITY_SHARD_SIZE = 64;
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// shard checker collecting the output raised on this thread, if any
+static thread_local validity_checker *s_thread_checker = nullptr;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -49,6 +67,26 @@ inline int validity_checker::get_defstr_index(const char *string, bool suppress_
 }
 
 
+//-------------------------------------------------
+//  find_duplicate - record a driver under a key,
+//  returning the earlier driver that already had
+//  the same key, if any
+//-------------------------------------------------
+
+const game_driver *validity_checker::find_duplicate(game_driver_map &map, const char *key)
+{
+	// shards only look at the map their parent filled in driver order
+	if (m_parent != nullptr)
+	{
+		auto const found = map.find(key);
+		return (found != map.end() && found->second != m_current_driver) ? found->second : nullptr;
+	}
+
+	auto const inserted = map.insert(std::make_pair(key, m_current_driver));
+	return inserted.second ? nullptr : inserted.first->second;
+}
+
+
 //-------------------------------------------------
 //  validate_tag - ensure that the given tag
 //  meets the general requirements
@@ -113,10 +151,12 @@ validity_checker::validity_checker(emu_options &options)
 		m_errors(0),
 		m_warnings(0),
 		m_print_verbose(options.verbose()),
+		m_parallel(false),
 		m_current_driver(nullptr),
 		m_current_config(nullptr),
 		m_current_device(nullptr),
-		m_current_ioport(nullptr)
+		m_current_ioport(nullptr),
+		m_parent(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -127,6 +167,13 @@ validity_checker::validity_checker(emu_options &options)
 	}
 }
 
+validity_checker::validity_checker(emu_options &options, validity_checker &parent)
+	: validity_checker(options)
+{
+	m_print_verbose = parent.m_print_verbose;
+	m_parent = &parent;
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
@@ -136,6 +183,23 @@ validity_checker::~validity_checker()
 	validate_end();
 }
 
+//-------------------------------------------------
+//  already_checked - claim a piece of shared
+//  data for checking; returns false if some
+//  driver already checked it
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	// shards share their parent's registry so each item is still only checked once
+	if (m_parent != nullptr)
+		return m_parent->already_checked(string);
+
+	std::lock_guard<std::mutex> lock(m_checked_mutex);
+	return m_already_checked.insert(string).second;
+}
+
+
 //-------------------------------------------------
 //  check_driver - check a single driver
 //-------------------------------------------------
@@ -184,22 +248,19 @@ bool validity_checker::check_all_matching(const char *string)
 
 	// if we had warnings or errors, output
 	if (m_errors > 0 || m_warnings > 0 || !m_verbose_text.empty())
-	{
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Core: %d errors, %d warnings\n", m_errors, m_warnings);
-		if (m_errors > 0)
-			output_indented_errors(m_error_text, "Errors");
-		if (m_warnings > 0)
-			output_indented_errors(m_warning_text, "Warnings");
-		if (!m_verbose_text.empty())
-			output_indented_errors(m_verbose_text, "Messages");
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
-	}
+		output_report(string_format("Core: %d errors, %d warnings\n", m_errors, m_warnings), m_errors > 0, m_warnings > 0);
 
-	// then iterate over all drivers and check them
+	// then gather all matching drivers and check them
+	std::vector<int> drivers;
 	m_drivlist.reset();
 	while (m_drivlist.next())
 		if (m_drivlist.matches(string, m_drivlist.driver().name))
-			validate_one(m_drivlist.driver());
+			drivers.push_back(m_drivlist.current());
+	if (m_parallel && drivers.size() > 1)
+		validate_parallel(drivers);
+	else
+		for (int index : drivers)
+			validate_one(m_drivlist.driver(index));
 
 	// cleanup
 	validate_end();
@@ -216,8 +277,9 @@ bool validity_checker::check_all_matching(const char *string)
 
 void validity_checker::validate_begin()
 {
-	// take over error and warning outputs
-	osd_output::push(this);
+	// take over error and warning outputs; shards get theirs through the parent
+	if (m_parent == nullptr)
+		osd_output::push(this);
 
 	// reset all our maps
 	m_names_map.clear();
@@ -241,7 +303,8 @@ void validity_checker::validate_begin()
 void validity_checker::validate_end()
 {
 	// restore the original output callbacks
-	osd_output::pop(this);
+	if (m_parent == nullptr)
+		osd_output::pop(this);
 }
 
 
@@ -283,16 +346,7 @@ void validity_checker::validate_one(const game_driver &driver)
 
 	// if we had warnings or errors, output
 	if (m_errors > start_errors || m_warnings > start_warnings || !m_verbose_text.empty())
-	{
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(driver.source_file).c_str(), m_errors - start_errors, m_warnings - start_warnings);
-		if (m_errors > start_errors)
-			output_indented_errors(m_error_text, "Errors");
-		if (m_warnings > start_warnings)
-			output_indented_errors(m_warning_text, "Warnings");
-		if (!m_verbose_text.empty())
-			output_indented_errors(m_verbose_text, "Messages");
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
-	}
+		output_report(string_format("Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(driver.source_file).c_str(), m_errors - start_errors, m_warnings - start_warnings), m_errors > start_errors, m_warnings > start_warnings);
 
 	// reset the driver/device
 	m_current_driver = nullptr;
@@ -302,6 +356,79 @@ void validity_checker::validate_one(const game_driver &driver)
 }
 
 
+//-------------------------------------------------
+//  validate_parallel - check a list of drivers
+//  in shards across the worker threads, then
+//  output the results in driver order
+//-------------------------------------------------
+
+void validity_checker::validate_parallel(const std::vector<int> &drivers)
+{
+	// fill the duplicate maps up front so every shard sees the first occurrence a serial check would
+	for (int index : drivers)
+	{
+		const game_driver &driver = m_drivlist.driver(index);
+		m_names_map.insert(std::make_pair(driver.name, &driver));
+		m_descriptions_map.insert(std::make_pair(driver.description, &driver));
+	}
+
+	// split the drivers into shards
+	std::vector<validity_shard> shards;
+	for (int start = 0; start < int(drivers.size()); start += VALIDITY_SHARD_SIZE)
+		shards.push_back({ this, &drivers, start, MIN(start + VALIDITY_SHARD_SIZE, int(drivers.size())), 0, 0, std::string() });
+
+	// check them on a work queue if we can get one, otherwise just inline
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue != nullptr)
+	{
+		osd_work_item_queue_multiple(queue, validate_shard, shards.size(), &shards[0], sizeof(shards[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, 100 * osd_ticks_per_second())) { }
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (validity_shard &shard : shards)
+			validate_shard(&shard, 0);
+	}
+
+	// merge the results in order
+	for (validity_shard &shard : shards)
+	{
+		m_errors += shard.errors;
+		m_warnings += shard.warnings;
+		if (!shard.report.empty())
+			output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", shard.report.c_str());
+	}
+}
+
+
+//-------------------------------------------------
+//  validate_shard - check one shard of drivers
+//  with a private checker; runs on a worker
+//  thread
+//-------------------------------------------------
+
+void *validity_checker::validate_shard(void *param, int threadid)
+{
+	validity_shard &shard = *reinterpret_cast<validity_shard *>(param);
+	validity_checker checker(shard.parent->m_drivlist.options(), *shard.parent);
+
+	// route everything raised on this thread to our checker while we work
+	validity_checker *const previous = s_thread_checker;
+	s_thread_checker = &checker;
+	checker.validate_begin();
+	for (int index = shard.start; index < shard.end; index++)
+		checker.validate_one(driver_list::driver((*shard.drivers)[index]));
+	checker.validate_end();
+	s_thread_checker = previous;
+
+	shard.errors = checker.m_errors;
+	shard.warnings = checker.m_warnings;
+	shard.report = std::move(checker.m_report);
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  validate_core - validate core internal systems
 //-------------------------------------------------
@@ -488,18 +615,14 @@ void validity_checker::validate_inlines()
 void validity_checker::validate_driver()
 {
 	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
-	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
+	const game_driver *match = find_duplicate((m_parent != nullptr) ? m_parent->m_names_map : m_names_map, m_current_driver->name);
+	if (match != nullptr)
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->source_file).c_str(), match->name);
-	}
 
 	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->description, m_current_driver)).second)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->description)->second;
+	match = find_duplicate((m_parent != nullptr) ? m_parent->m_descriptions_map : m_descriptions_map, m_current_driver->description);
+	if (match != nullptr)
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->source_file).c_str(), match->name);
-	}
 
 	// determine if we are a clone
 	bool is_clone = (strcmp(m_current_driver->parent, "0") != 0);
@@ -1017,6 +1140,14 @@ void validity_checker::build_output_prefix(std::string &str)
 
 void validity_checker::output_callback(osd_output_channel channel, const char *msg, va_list args)
 {
+	// output raised on a worker thread belongs to the shard checking there
+	validity_checker *const target = s_thread_checker;
+	if (target != nullptr && target != this)
+	{
+		target->output_callback(channel, msg, args);
+		return;
+	}
+
 	std::string output;
 	switch (channel)
 	{
@@ -1054,7 +1185,11 @@ void validity_checker::output_callback(osd_output_channel channel, const char *m
 			m_verbose_text.append(output);
 			break;
 		default:
-			chain_output(channel, msg, args);
+			// shards aren't on the output stack, so pass through their parent's chain
+			if (m_parent != nullptr)
+				m_parent->chain_output(channel, msg, args);
+			else
+				chain_output(channel, msg, args);
 			break;
 	}
 }
@@ -1069,21 +1204,47 @@ void validity_checker::output_via_delegate(osd_output_channel channel, const cha
 {
 	va_list argptr;
 
-	// call through to the delegate with the proper parameters
+	// call through to the delegate with the proper parameters; shards hold it for their parent
 	va_start(argptr, format);
-	this->chain_output(channel, format, argptr);
+	if (m_parent != nullptr)
+		strcatvprintf(m_report, format, argptr);
+	else
+		this->chain_output(channel, format, argptr);
 	va_end(argptr);
 }
 
 //-------------------------------------------------
-//  output_indented_errors - helper to output error
+//  output_report - output the messages collected
+//  for the core or a driver under a header line;
+//  shards hold them for their parent instead
+//-------------------------------------------------
+
+void validity_checker::output_report(const std::string &header, bool errors, bool warnings)
+{
+	std::string report(header);
+	if (errors)
+		append_indented_errors(report, m_error_text, "Errors");
+	if (warnings)
+		append_indented_errors(report, m_warning_text, "Warnings");
+	if (!m_verbose_text.empty())
+		append_indented_errors(report, m_verbose_text, "Messages");
+	report.append("\n");
+
+	if (m_parent != nullptr)
+		m_report.append(report);
+	else
+		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", report.c_str());
+}
+
+//-------------------------------------------------
+//  append_indented_errors - helper to format error
 //  and warning messages with header and indents
 //-------------------------------------------------
-void validity_checker::output_indented_errors(std::string &text, const char *header)
+void validity_checker::append_indented_errors(std::string &dest, std::string &text, const char *header)
 {
 	// remove trailing newline
 	if (text[text.size()-1] == '\n')
 		text.erase(text.size()-1, 1);
 	strreplace(text, "\n", "\n   ");
-	output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s:\n   %s\n", header, text.c_str());
+	dest.append(string_format("%s:\n   %s\n", header, text.c_str()));
 }
@@ -16,6 +16,8 @@
 #include "emu.h"
 #include "drivenum.h"
 
+#include <mutex>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -40,8 +42,9 @@ public:
 	int errors() const { return m_errors; }
 	int warnings() const { return m_warnings; }
 
-	// setter
+	// setters
 	void set_verbose(bool verbose) { m_print_verbose = verbose; }
+	void set_parallel(bool parallel) { m_parallel = parallel; }
 
 	// operations
 	void check_driver(const game_driver &driver);
@@ -53,7 +56,7 @@ public:
 	int region_length(const char *tag) { return m_region_map.find(tag)->second; }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return m_already_checked.insert(string).second; }
+	bool already_checked(const char *string);
 
 	// osd_output interface
 
@@ -61,14 +64,32 @@ protected:
 	virtual void output_callback(osd_output_channel channel, const char *msg, va_list args) override;
 
 private:
+	// a run of drivers checked on a worker thread by its own checker
+	struct validity_shard
+	{
+		validity_checker *      parent;
+		const std::vector<int> *drivers;
+		int                     start;
+		int                     end;
+		int                     errors;
+		int                     warnings;
+		std::string             report;
+	};
+
+	// checker for one shard, reporting back to a parent
+	validity_checker(emu_options &options, validity_checker &parent);
+
 	// internal helpers
 	const char *ioport_string_from_index(UINT32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
+	const game_driver *find_duplicate(game_driver_map &map, const char *key);
 
 	// core helpers
 	void validate_begin();
 	void validate_end();
 	void validate_one(const game_driver &driver);
+	void validate_parallel(const std::vector<int> &drivers);
+	static void *validate_shard(void *param, int threadid);
 
 	// internal sub-checks
 	void validate_core();
@@ -84,7 +105,8 @@ private:
 	// output helpers
 	void build_output_prefix(std::string &str);
 	void output_via_delegate(osd_output_channel channel, const char *format, ...) ATTR_PRINTF(3,4);
-	void output_indented_errors(std::string &text, const char *header);
+	void output_report(const std::string &header, bool errors, bool warnings);
+	void append_indented_errors(std::string &dest, std::string &text, const char *header);
 
 	// internal driver list
 	driver_enumerator       m_drivlist;
@@ -93,9 +115,11 @@ private:
 	int                     m_errors;
 	int                     m_warnings;
 	bool                    m_print_verbose;
+	bool                    m_parallel;
 	std::string             m_error_text;
 	std::string             m_warning_text;
 	std::string             m_verbose_text;
+	std::string             m_report;           // reports held for the parent, when checking a shard
 
 	// maps for finding duplicates
 	game_driver_map         m_names_map;
@@ -111,6 +135,10 @@ private:
 	int_map                 m_region_map;
 	std::unordered_set<std::string>   m_already_checked;
 
+	// parallel checking
+	validity_checker *      m_parent;           // checker we are a shard of, or nullptr
+	std::mutex              m_checked_mutex;    // protects m_already_checked while shards run
+
 };
 
 #endif
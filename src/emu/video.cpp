@@ -98,6 +98,7 @@ video_manager::video_manager(running_machine &machine)
 		m_skipping_this_frame(false),
 		m_average_oversleep(0),
 		m_snap_target(nullptr),
+		m_snap_queue(nullptr),
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
@@ -587,6 +588,9 @@ void video_manager::exit()
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_snap_queue != nullptr)
+		osd_work_queue_free(m_snap_queue);
+	m_snap_queue = nullptr;
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (m_overall_emutime.seconds() >= 1)
@@ -1132,13 +1136,17 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	if (!m_snap_bitmap.valid() || width != m_snap_bitmap.width() || height != m_snap_bitmap.height())
 		m_snap_bitmap.allocate(width, height);
 
+	// movie recording renders every frame, so split the work across processors
+	if (m_snap_queue == nullptr)
+		m_snap_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// render the screen there
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_snap_queue);
 	primlist.release_lock();
 }
 
@@ -189,6 +189,8 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
+	std::lock_guard<std::mutex> lock(m_file_mutex);
+
 	// seek and read
 	m_file->seek(offset, SEEK_SET);
 	UINT32 count = m_file->read(dest, length);
@@ -208,6 +210,8 @@ inline void chd_file::file_write(UINT64 offset, const void *source, UINT32 lengt
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
+	std::lock_guard<std::mutex> lock(m_file_mutex);
+
 	// seek and write
 	m_file->seek(offset, SEEK_SET);
 	UINT32 count = m_file->write(source, length);
@@ -228,6 +232,8 @@ inline UINT64 chd_file::file_append(const void *source, UINT32 length, UINT32 al
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
+	std::lock_guard<std::mutex> lock(m_file_mutex);
+
 	// seek to the end and align if necessary
 	m_file->seek(0, SEEK_END);
 	if (alignment != 0)
@@ -289,7 +295,10 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_cache_bytes(DEFAULT_CACHE_BYTES),
+		m_readahead_hunks(DEFAULT_READAHEAD_HUNKS),
+		m_readahead_queue(nullptr)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
@@ -801,6 +810,9 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// stop any read-ahead before the file goes away
+	readahead_stop();
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -843,7 +855,8 @@ void chd_file::close()
 
 	// reset caching
 	m_cache.clear();
-	m_cachehunk = ~0;
+	m_cachemap.clear();
+	m_lasthunk = ~0;
 }
 
 /**
@@ -1052,9 +1065,12 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 					break;
 				}
 
-			// if it's all zeros, do nothing more
+			// if it's all zeros, do nothing more; a cached copy may now differ from what reads return
 			if (all_zeros)
+			{
+				cache_invalidate(hunknum);
 				return CHDERR_NONE;
+			}
 
 			// append new data to the end of the file, aligning the first chunk
 			rawentry = file_append(buffer, m_hunkbytes, m_hunkbytes) / m_hunkbytes;
@@ -1062,15 +1078,14 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
 		else
 			file_write(UINT64(rawentry) * UINT64(m_hunkbytes), buffer, m_hunkbytes);
+
+		// update the cached hunk if we just wrote it
+		cache_update(hunknum, buffer);
 		return CHDERR_NONE;
 	}
 
@@ -1123,8 +1138,9 @@ chd_error chd_file::write_units(UINT64 unitnum, const void *buffer, UINT32 count
  * @fn  chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
  *
  * @brief   -------------------------------------------------
- *            read_bytes - read from the CHD at a byte level, using the cache to handle partial
- *            hunks
+ *            read_bytes - read from the CHD at a byte level, going through the hunk cache
+ *            so that repeated and sequential accesses avoid decompressing again; whole hunks
+ *            that aren't cached are read directly into the buffer
  *          -------------------------------------------------.
  *
  * @param   offset          The offset.
@@ -1146,27 +1162,32 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
-		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
-			err = read_hunk(curhunk, dest);
+		// whole hunks that aren't cached go straight to the caller, so streaming doesn't flush the cache
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && cache_find(curhunk) == nullptr)
+		{
+			chd_error err = CHDERR_NONE;
+			if (!readahead_claim(curhunk, err, dest))
+				err = read_hunk(curhunk, dest);
+			if (err != CHDERR_NONE)
+				return err;
+
+			// keep the read-ahead going if we are streaming
+			if (curhunk == m_lasthunk + 1)
+				readahead_start(curhunk + 1);
+			m_lasthunk = curhunk;
+		}
 
-		// otherwise, read from the cache
+		// otherwise, read through the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			UINT8 *data;
+			chd_error err = cache_fetch(curhunk, data);
+			if (err != CHDERR_NONE)
+				return err;
+			memcpy(dest, &data[startoffs], endoffs + 1 - startoffs);
 		}
 
-		// handle errors and advance
-		if (err != CHDERR_NONE)
-			return err;
+		// advance
 		dest += endoffs + 1 - startoffs;
 	}
 	return CHDERR_NONE;
@@ -1199,23 +1220,20 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk; write_hunk keeps any cached copy current
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = write_hunk(curhunk, source);
 
-		// otherwise, write from the cache
+		// otherwise, merge into the cached hunk and write that
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, &m_cache[0]);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
+			UINT8 *data;
+			err = cache_fetch(curhunk, data);
+			if (err != CHDERR_NONE)
+				return err;
+			memcpy(&data[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, data);
 		}
 
 		// handle errors and advance
@@ -2469,7 +2487,6 @@ void chd_file::create_open_common()
 
 	// allocate the temporary compressed buffer and a buffer for caching
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
 }
 
 /**
@@ -2741,6 +2758,429 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
 
 
 
+//**************************************************************************
+//  CHD HUNK CACHE
+//**************************************************************************
+
+/**
+ * @fn  chd_file::readahead_item::readahead_item(chd_file &chd)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_item - constructor; each item gets its own set of decompressors so
+ *            that several hunks can be decompressed at once
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  chd The CHD we are reading ahead for.
+ */
+
+chd_file::readahead_item::readahead_item(chd_file &chd)
+	: m_chd(chd),
+		m_osd(nullptr),
+		m_hunknum(~0),
+		m_type(0),
+		m_offset(0),
+		m_length(0),
+		m_crc(0),
+		m_error(CHDERR_NONE)
+{
+	for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_decompressor); decompnum++)
+		m_decompressor[decompnum] = chd_codec_list::new_decompressor(chd.m_compression[decompnum], chd);
+	m_compressed.resize(chd.m_hunkbytes);
+	m_data.resize(chd.m_hunkbytes);
+}
+
+/**
+ * @fn  chd_file::readahead_item::~readahead_item()
+ *
+ * @brief   -------------------------------------------------
+ *            ~readahead_item - destructor
+ *          -------------------------------------------------.
+ */
+
+chd_file::readahead_item::~readahead_item()
+{
+	for (auto & elem : m_decompressor)
+		delete elem;
+}
+
+/**
+ * @fn  void chd_file::set_cache_size(UINT64 bytes)
+ *
+ * @brief   -------------------------------------------------
+ *            set_cache_size - set the upper bound on the memory used to hold decompressed
+ *            hunks; at least one hunk is always kept
+ *          -------------------------------------------------.
+ *
+ * @param   bytes   The number of bytes.
+ */
+
+void chd_file::set_cache_size(UINT64 bytes)
+{
+	m_cache_bytes = bytes;
+	cache_trim();
+}
+
+/**
+ * @fn  void chd_file::set_readahead(UINT32 hunks)
+ *
+ * @brief   -------------------------------------------------
+ *            set_readahead - set how many hunks are decompressed ahead of a sequential
+ *            reader; 0 disables read-ahead
+ *          -------------------------------------------------.
+ *
+ * @param   hunks   The number of hunks.
+ */
+
+void chd_file::set_readahead(UINT32 hunks)
+{
+	readahead_stop();
+	m_readahead_hunks = MIN(hunks, MAX_READAHEAD_HUNKS);
+}
+
+/**
+ * @fn  UINT8 *chd_file::cache_find(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_find - return the cached data for a hunk, marking it most recently
+ *            used, or NULL if it is not cached
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if not cached, else a pointer to the data.
+ */
+
+UINT8 *chd_file::cache_find(UINT32 hunknum)
+{
+	auto found = m_cachemap.find(hunknum);
+	if (found == m_cachemap.end())
+		return nullptr;
+	m_cache.splice(m_cache.begin(), m_cache, found->second);
+	return &found->second->m_data[0];
+}
+
+/**
+ * @fn  UINT8 *chd_file::cache_allocate(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_allocate - return a cache entry for the given hunk, recycling the least
+ *            recently used entry if the cache is full; the contents are undefined
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  A pointer to the entry's data.
+ */
+
+UINT8 *chd_file::cache_allocate(UINT32 hunknum)
+{
+	UINT8 *data = cache_find(hunknum);
+	if (data != nullptr)
+		return data;
+
+	// recycle the oldest entry if we are at capacity, otherwise make a new one
+	UINT64 capacity = MAX(m_cache_bytes / m_hunkbytes, 1);
+	if (m_cache.size() >= capacity)
+	{
+		m_cachemap.erase(m_cache.back().m_hunknum);
+		m_cache.splice(m_cache.begin(), m_cache, std::prev(m_cache.end()));
+	}
+	else
+	{
+		m_cache.emplace_front();
+		m_cache.front().m_data.resize(m_hunkbytes);
+	}
+	m_cache.front().m_hunknum = hunknum;
+	m_cachemap[hunknum] = m_cache.begin();
+	return &m_cache.front().m_data[0];
+}
+
+/**
+ * @fn  void chd_file::cache_update(UINT32 hunknum, const void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_update - refresh the cached copy of a hunk, if any, after it was written
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ * @param   buffer  The data that was written.
+ */
+
+void chd_file::cache_update(UINT32 hunknum, const void *buffer)
+{
+	auto found = m_cachemap.find(hunknum);
+	if (found != m_cachemap.end() && buffer != &found->second->m_data[0])
+		memcpy(&found->second->m_data[0], buffer, m_hunkbytes);
+}
+
+/**
+ * @fn  void chd_file::cache_invalidate(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_invalidate - drop a hunk from the cache
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ */
+
+void chd_file::cache_invalidate(UINT32 hunknum)
+{
+	auto found = m_cachemap.find(hunknum);
+	if (found != m_cachemap.end())
+	{
+		m_cache.erase(found->second);
+		m_cachemap.erase(found);
+	}
+}
+
+/**
+ * @fn  void chd_file::cache_trim()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_trim - release least recently used entries until the cache fits in its
+ *            memory budget
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cache_trim()
+{
+	UINT64 capacity = (m_hunkbytes == 0) ? 1 : MAX(m_cache_bytes / m_hunkbytes, 1);
+	while (m_cache.size() > capacity)
+	{
+		m_cachemap.erase(m_cache.back().m_hunknum);
+		m_cache.pop_back();
+	}
+}
+
+/**
+ * @fn  chd_error chd_file::cache_fetch(UINT32 hunknum, UINT8 *&data)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_fetch - return the cached data for a hunk, reading it (or collecting it
+ *            from the read-ahead) on a miss, and kick off read-ahead if the misses look
+ *            sequential
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [out]     data    Receives a pointer to the hunk's data.
+ *
+ * @return  A chd_error.
+ */
+
+chd_error chd_file::cache_fetch(UINT32 hunknum, UINT8 *&data)
+{
+	data = cache_find(hunknum);
+	if (data != nullptr)
+		return CHDERR_NONE;
+
+	// a miss; take it from the read-ahead if it's there, otherwise read it now
+	chd_error err = CHDERR_NONE;
+	if (!readahead_claim(hunknum, err))
+		err = read_hunk(hunknum, cache_allocate(hunknum));
+	if (err != CHDERR_NONE)
+	{
+		cache_invalidate(hunknum);
+		return err;
+	}
+	data = cache_find(hunknum);
+
+	// if we are streaming, keep the next few hunks coming
+	if (hunknum == m_lasthunk + 1)
+		readahead_start(hunknum + 1);
+	m_lasthunk = hunknum;
+	return CHDERR_NONE;
+}
+
+/**
+ * @fn  void chd_file::readahead_start(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_start - queue decompression of the hunks following a sequential
+ *            reader; only read-only v5 CHDs using lossless codecs are handled, and hunks
+ *            that reference other hunks or the parent are left for read_hunk
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The first hunk to read ahead.
+ */
+
+void chd_file::readahead_start(UINT32 hunknum)
+{
+	if (m_readahead_hunks == 0 || m_version < 5 || !compressed() || m_allow_writes)
+		return;
+
+	// allocate the queue and slots on first use
+	if (m_readahead_queue == nullptr)
+	{
+		m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_readahead_queue == nullptr)
+			return;
+		for (UINT32 itemnum = 0; itemnum < m_readahead_hunks; itemnum++)
+			m_readahead.emplace_back(std::make_unique<readahead_item>(*this));
+	}
+
+	UINT32 endhunk = MIN(hunknum + m_readahead_hunks, m_hunkcount);
+	for ( ; hunknum < endhunk; hunknum++)
+	{
+		// skip anything already cached or in flight
+		if (m_cachemap.find(hunknum) != m_cachemap.end())
+			continue;
+		bool pending = false;
+		for (auto &item : m_readahead)
+			if (item->m_osd != nullptr && item->m_hunknum == hunknum)
+				pending = true;
+		if (pending)
+			continue;
+
+		// only handle hunks we can decompress standalone
+		UINT8 *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+		if (rawmap[0] > COMPRESSION_NONE)
+			continue;
+		if (rawmap[0] != COMPRESSION_NONE && (m_decompressor[rawmap[0]] == nullptr || m_decompressor[rawmap[0]]->lossy()))
+			continue;
+
+		// find an idle slot, recycling finished ones that fell out of the window
+		readahead_item *slot = nullptr;
+		for (auto &item : m_readahead)
+		{
+			if (item->m_osd != nullptr && (item->m_hunknum < hunknum || item->m_hunknum >= endhunk) && osd_work_item_wait(item->m_osd, 0))
+			{
+				osd_work_item_release(item->m_osd);
+				item->m_osd = nullptr;
+			}
+			if (item->m_osd == nullptr)
+			{
+				slot = item.get();
+				break;
+			}
+		}
+		if (slot == nullptr)
+			break;
+
+		// capture what the worker needs from the map and queue it
+		slot->m_hunknum = hunknum;
+		slot->m_type = rawmap[0];
+		slot->m_length = be_read(&rawmap[1], 3);
+		slot->m_offset = be_read(&rawmap[4], 6);
+		slot->m_crc = be_read(&rawmap[10], 2);
+		slot->m_error = CHDERR_NONE;
+		slot->m_osd = osd_work_item_queue(m_readahead_queue, async_readahead_static, slot, 0);
+	}
+}
+
+/**
+ * @fn  bool chd_file::readahead_claim(UINT32 hunknum, chd_error &err)
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_claim - if a hunk is being read ahead, wait for it and move the
+ *            result into the cache, or copy it to dest if one is given
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [out]     err     Receives the result of the decompression.
+ * @param [out]     dest    If non-null, receives the data instead of the cache.
+ *
+ * @return  true if the hunk was handled by the read-ahead.
+ */
+
+bool chd_file::readahead_claim(UINT32 hunknum, chd_error &err, void *dest)
+{
+	for (auto &item : m_readahead)
+		if (item->m_osd != nullptr && item->m_hunknum == hunknum)
+		{
+			while (!osd_work_item_wait(item->m_osd, osd_ticks_per_second())) { }
+			osd_work_item_release(item->m_osd);
+			item->m_osd = nullptr;
+
+			// swap the buffers rather than copying
+			err = item->m_error;
+			if (err == CHDERR_NONE && dest != nullptr)
+				memcpy(dest, &item->m_data[0], m_hunkbytes);
+			else if (err == CHDERR_NONE)
+			{
+				cache_allocate(hunknum);
+				item->m_data.swap(m_cache.front().m_data);
+			}
+			return true;
+		}
+	return false;
+}
+
+/**
+ * @fn  void chd_file::readahead_stop()
+ *
+ * @brief   -------------------------------------------------
+ *            readahead_stop - wait for any outstanding read-ahead and release the slots and
+ *            the queue
+ *          -------------------------------------------------.
+ */
+
+void chd_file::readahead_stop()
+{
+	for (auto &item : m_readahead)
+		if (item->m_osd != nullptr)
+		{
+			while (!osd_work_item_wait(item->m_osd, osd_ticks_per_second())) { }
+			osd_work_item_release(item->m_osd);
+		}
+	m_readahead.clear();
+	if (m_readahead_queue != nullptr)
+		osd_work_queue_free(m_readahead_queue);
+	m_readahead_queue = nullptr;
+}
+
+/**
+ * @fn  void *chd_file::async_readahead_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_readahead - read and decompress a single hunk on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   The readahead_item.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::async_readahead_static(void *param, int threadid)
+{
+	readahead_item *item = reinterpret_cast<readahead_item *>(param);
+	item->m_chd.async_readahead(*item);
+	return nullptr;
+}
+
+/**
+ * @fn  void chd_file::async_readahead(readahead_item &item)
+ *
+ * @brief   Asynchronous read-ahead of a hunk; mirrors the v5 compressed path of read_hunk
+ *          using the item's own buffers and codecs.
+ *
+ * @param [in,out]  item    The item.
+ */
+
+void chd_file::async_readahead(readahead_item &item)
+{
+	try
+	{
+		if (item.m_type == COMPRESSION_NONE)
+			file_read(item.m_offset, &item.m_data[0], m_hunkbytes);
+		else
+		{
+			file_read(item.m_offset, &item.m_compressed[0], item.m_length);
+			if (item.m_decompressor[item.m_type] == nullptr)
+				throw CHDERR_UNSUPPORTED_FORMAT;
+			item.m_decompressor[item.m_type]->decompress(&item.m_compressed[0], item.m_length, &item.m_data[0], m_hunkbytes);
+		}
+		if (crc16_creator::simple(&item.m_data[0], m_hunkbytes) != item.m_crc)
+			throw CHDERR_DECOMPRESSION_ERROR;
+	}
+	catch (chd_error &err)
+	{
+		item.m_error = err;
+	}
+}
+
+
+
 //**************************************************************************
 //  CHD COMPRESSOR
 //**************************************************************************
@@ -22,6 +22,10 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 /***************************************************************************
 
@@ -299,6 +303,11 @@ class chd_file
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
 public:
+	// cache defaults
+	static const UINT64 DEFAULT_CACHE_BYTES = 4 * 1024 * 1024;
+	static const UINT32 DEFAULT_READAHEAD_HUNKS = 4;
+	static const UINT32 MAX_READAHEAD_HUNKS = 32;
+
 	// construction/destruction
 	chd_file();
 	virtual ~chd_file();
@@ -325,6 +334,8 @@ public:
 	// setters
 	void set_raw_sha1(sha1_t rawdata);
 	void set_parent_sha1(sha1_t parent);
+	void set_cache_size(UINT64 bytes);
+	void set_readahead(UINT32 hunks);
 
 	// file create
 	chd_error create(const char *filename, UINT64 logicalbytes, UINT32 hunkbytes, UINT32 unitbytes, chd_codec_type compression[4]);
@@ -371,6 +382,32 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// a single decompressed hunk held in the cache
+	struct cache_entry
+	{
+		UINT32              m_hunknum;          // which hunk is this?
+		dynamic_buffer      m_data;             // decompressed data
+	};
+
+	// a hunk being decompressed ahead of the reader
+	struct readahead_item
+	{
+		readahead_item(chd_file &chd);
+		~readahead_item();
+
+		chd_file &          m_chd;              // pointer back to the CHD
+		osd_work_item *     m_osd;              // OSD work item running on this hunk, or NULL if idle
+		UINT32              m_hunknum;          // number of the hunk we're working on
+		UINT8               m_type;             // v5 compression type from the map
+		UINT64              m_offset;           // offset of the hunk data in the file
+		UINT32              m_length;           // length of the hunk data in the file
+		UINT16              m_crc;              // expected CRC-16 of the decompressed data
+		chd_error           m_error;            // result of the decompression
+		chd_decompressor *  m_decompressor[4];  // private decompression codecs
+		dynamic_buffer      m_compressed;       // compressed data
+		dynamic_buffer      m_data;             // decompressed data
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -400,6 +437,19 @@ private:
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
 
+	// cache management
+	UINT8 *cache_find(UINT32 hunknum);
+	UINT8 *cache_allocate(UINT32 hunknum);
+	void cache_update(UINT32 hunknum, const void *buffer);
+	void cache_invalidate(UINT32 hunknum);
+	void cache_trim();
+	chd_error cache_fetch(UINT32 hunknum, UINT8 *&data);
+	void readahead_start(UINT32 hunknum);
+	bool readahead_claim(UINT32 hunknum, chd_error &err, void *dest = nullptr);
+	void readahead_stop();
+	static void *async_readahead_static(void *param, int threadid);
+	void async_readahead(readahead_item &item);
+
 	// file characteristics
 	util::core_file *       m_file;             // handle to the open core file
 	bool                    m_owns_file;        // flag indicating if this file should be closed on chd_close()
@@ -435,8 +485,14 @@ private:
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
-	UINT32                  m_cachehunk;        // which hunk is in the cache?
+	std::list<cache_entry>  m_cache;            // decompressed hunks, most recently used first
+	std::unordered_map<UINT32, std::list<cache_entry>::iterator> m_cachemap; // hunk number to cache entry
+	UINT64                  m_cache_bytes;      // upper bound on the memory used by the cache
+	UINT32                  m_lasthunk;         // last hunk that missed the cache, to detect streaming
+	UINT32                  m_readahead_hunks;  // number of hunks to decompress ahead of the reader
+	osd_work_queue *        m_readahead_queue;  // queue used for read-ahead
+	std::vector<std::unique_ptr<readahead_item>> m_readahead; // read-ahead slots
+	std::mutex              m_file_mutex;       // serializes access to m_file
 };
 
 
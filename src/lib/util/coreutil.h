@@ -33,6 +33,35 @@ int gregorian_is_leap_year(int year);
 int gregorian_days_in_month(int month, int year);
 
 
+/***************************************************************************
+    LITTLE-ENDIAN SERIALIZATION HELPERS
+***************************************************************************/
+
+static inline void put_le32(UINT8 *dest, UINT32 value)
+{
+	dest[0] = value >> 0;
+	dest[1] = value >> 8;
+	dest[2] = value >> 16;
+	dest[3] = value >> 24;
+}
+
+static inline void put_le64(UINT8 *dest, UINT64 value)
+{
+	put_le32(&dest[0], UINT32(value));
+	put_le32(&dest[4], UINT32(value >> 32));
+}
+
+static inline UINT32 get_le32(const UINT8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (UINT32(src[3]) << 24);
+}
+
+static inline UINT64 get_le64(const UINT8 *src)
+{
+	return get_le32(&src[0]) | (UINT64(get_le32(&src[4])) << 32);
+}
+
+
 /***************************************************************************
     MISC
 ***************************************************************************/
@@ -22,10 +22,13 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <list>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -102,13 +105,14 @@ public:
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
 		{
 			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
+				s_cache_bytes -= result->memory_used();
 				return result;
 			}
 		}
@@ -119,26 +123,18 @@ public:
 	{
 		// clear call cache entries
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		s_cache.clear();
+		s_cache_bytes = 0;
 	}
 
 	archive_file::error initialize();
 
-	int first_file() { return search(0, 0, std::string(), false, false, false); }
-	int next_file() { return (m_curr_file_idx < 0) ? -1 : search(m_curr_file_idx + 1, 0, std::string(), false, false, false); }
+	int first_file() { return m_entries.empty() ? -1 : select(0); }
+	int next_file() { return ((m_curr_file_idx < 0) || ((m_curr_file_idx + 1) >= int(m_entries.size()))) ? -1 : select(m_curr_file_idx + 1); }
 
-	int search(std::uint32_t crc)
-	{
-		return search(0, crc, std::string(), true, false, false);
-	}
-	int search(const std::string &filename, bool partialpath)
-	{
-		return search(0, 0, filename, false, true, partialpath);
-	}
-	int search(std::uint32_t crc, const std::string &filename, bool partialpath)
-	{
-		return search(0, crc, filename, true, true, partialpath);
-	}
+	int search(std::uint32_t crc);
+	int search(const std::string &filename, bool partialpath);
+	int search(std::uint32_t crc, const std::string &filename, bool partialpath);
 
 	bool current_is_directory() const { return m_curr_is_dir; }
 	const std::string &current_name() const { return m_curr_name; }
@@ -153,21 +149,37 @@ private:
 	m7z_file_impl &operator=(const m7z_file_impl &) = delete;
 	m7z_file_impl &operator=(m7z_file_impl &&) = delete;
 
-	int search(
-			int i,
-			std::uint32_t search_crc,
-			const std::string &search_filename,
-			bool matchcrc,
-			bool matchname,
-			bool partialpath);
+	// archive index
+	void index_files();
+	bool name_matches(int index, const std::string &search_filename, bool partialpath) const;
+	int select(int index);
+	std::size_t memory_used() const;
 	void make_utf8_name(int index);
 
-	static constexpr std::size_t        CACHE_SIZE = 8;
-	static std::array<ptr, CACHE_SIZE>  s_cache;
+	// one file in the archive
+	struct file_entry
+	{
+		std::uint64_t   length;                 // uncompressed length
+		std::uint32_t   crc;                    // crc-32
+		bool            is_dir;                 // entry is a directory
+		std::string     name;                   // UTF-8 filename
+	};
+
+	typedef std::unordered_multimap<std::uint32_t, int> crc_index;
+	typedef std::unordered_multimap<std::string, int> name_index;
+
+	static constexpr std::size_t        CACHE_BUDGET = 128 * 1024 * 1024; // memory closed files may keep cached, including solid blocks
+	static std::list<ptr>               s_cache;
+	static std::size_t                  s_cache_bytes;
 	static std::mutex                   s_cache_mutex;
 
 	const std::string           m_filename;             // copy of _7Z filename (for caching)
 
+	std::vector<file_entry>     m_entries;              // files in archive order
+	crc_index                   m_crc_index;            // CRC -> file index
+	name_index                  m_name_index;           // lowercase filename -> file index
+	name_index                  m_partial_index;        // lowercase trailing path components -> file index
+
 	int                         m_curr_file_idx;        // current file index
 	bool                        m_curr_is_dir;          // current file is directory
 	std::string                 m_curr_name;            // current file name
@@ -221,6 +233,7 @@ public:
 	virtual std::uint32_t current_crc() const override { return m_impl->current_crc(); }
 
 	virtual error decompress(void *buffer, std::uint32_t length) override { return m_impl->decompress(buffer, length); }
+	virtual error stored_location(std::string &filename, std::uint64_t &offset) override { return error::UNSUPPORTED; }
 
 private:
 	m7z_file_impl::ptr m_impl;
@@ -232,7 +245,8 @@ private:
     GLOBAL VARIABLES
 ***************************************************************************/
 
-std::array<m7z_file_impl::ptr, m7z_file_impl::CACHE_SIZE> m7z_file_impl::s_cache;
+std::list<m7z_file_impl::ptr> m7z_file_impl::s_cache;
+std::size_t m7z_file_impl::s_cache_bytes = 0;
 std::mutex m7z_file_impl::s_cache_mutex;
 
 
@@ -322,6 +336,10 @@ archive_file::error m7z_file_impl::initialize()
 	if (res != SZ_OK)
 		return archive_file::error::FILE_ERROR;
 
+	// convert the names once and index them so lookups don't need to walk the database
+	try { index_files(); }
+	catch (...) { return archive_file::error::OUT_OF_MEMORY; }
+
 	return archive_file::error::NONE;
 }
 
@@ -338,21 +356,17 @@ void m7z_file_impl::close(ptr &&archive)
 	// close the open files
 	archive->m_archive_stream.osdfile.reset();
 
-	// find the first NULL entry in the cache
+	// place us at the top of the cache
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
-			break;
-
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
-		s_cache[--cachenum].reset();
-
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(archive);
+	s_cache_bytes += archive->memory_used();
+	s_cache.push_front(std::move(archive));
+
+	// free the least recently used entries until we fit the budget again
+	while ((s_cache_bytes > CACHE_BUDGET) && !s_cache.empty())
+	{
+		s_cache_bytes -= s_cache.back()->memory_used();
+		s_cache.pop_back();
+	}
 }
 
 
@@ -396,42 +410,136 @@ archive_file::error m7z_file_impl::decompress(void *buffer, std::uint32_t length
 }
 
 
-int m7z_file_impl::search(
-		int i,
-		std::uint32_t search_crc,
-		const std::string &search_filename,
-		bool matchcrc,
-		bool matchname,
-		bool partialpath)
+/*-------------------------------------------------
+    index_files - convert every name in the
+    archive once, building lookup tables by CRC
+    and by name
+-------------------------------------------------*/
+
+void m7z_file_impl::index_files()
 {
-	for ( ; i < m_db.db.NumFiles; i++)
+	m_entries.reserve(m_db.db.NumFiles);
+	for (int i = 0; i < int(m_db.db.NumFiles); i++)
 	{
 		const CSzFileItem &f(m_db.db.Files[i]);
-
 		make_utf8_name(i);
-		const std::uint64_t size(f.Size);
-		const std::uint32_t crc(f.Crc);
-		const bool crcmatch(crc == search_crc);
-		auto const partialoffset(m_utf8_buf.size() - 1 - search_filename.length());
-		bool const partialpossible((m_utf8_buf.size() > (search_filename.length() + 1)) && (m_utf8_buf[partialoffset - 1] == '/'));
-		const bool namematch(
-				!core_stricmp(search_filename.c_str(), &m_utf8_buf[0]) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), &m_utf8_buf[partialoffset])));
-
-		const bool found = ((!matchcrc && !matchname) || !f.IsDir) && (!matchcrc || crcmatch) && (!matchname || namematch);
-		if (found)
-		{
-			m_curr_file_idx = i;
-			m_curr_is_dir = bool(f.IsDir);
-			m_curr_name = &m_utf8_buf[0];
-			m_curr_length = size;
-			m_curr_crc = crc;
 
-			return i;
-		}
+		file_entry entry;
+		entry.length = f.Size;
+		entry.crc = f.Crc;
+		entry.is_dir = bool(f.IsDir);
+		entry.name = &m_utf8_buf[0];
+		m_entries.emplace_back(std::move(entry));
+	}
+
+	// directories are never returned by searches, so leave them out of the indexes
+	m_crc_index.reserve(m_entries.size());
+	m_name_index.reserve(m_entries.size());
+	for (int i = 0; i < int(m_entries.size()); i++)
+	{
+		file_entry const &entry = m_entries[i];
+		if (entry.is_dir)
+			continue;
+
+		std::string lowername(entry.name);
+		std::transform(lowername.begin(), lowername.end(), lowername.begin(), [] (char ch) { return char(std::tolower(std::uint8_t(ch))); });
+		m_crc_index.emplace(entry.crc, i);
+		for (std::string::size_type sep = lowername.find('/'); sep != std::string::npos; sep = lowername.find('/', sep + 1))
+			m_partial_index.emplace(lowername.substr(sep + 1), i);
+		m_name_index.emplace(std::move(lowername), i);
+	}
+}
+
+
+/*-------------------------------------------------
+    name_matches - check whether a file matches
+    the name being searched for
+-------------------------------------------------*/
+
+bool m7z_file_impl::name_matches(int index, const std::string &search_filename, bool partialpath) const
+{
+	std::string const &filename = m_entries[index].name;
+	auto const partialoffset(filename.length() - search_filename.length());
+	bool const partialpossible((filename.length() > search_filename.length()) && (filename[partialoffset - 1] == '/'));
+	return !core_stricmp(search_filename.c_str(), filename.c_str()) ||
+			(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), filename.c_str() + partialoffset));
+}
+
+
+/*-------------------------------------------------
+    select - make a file current
+-------------------------------------------------*/
+
+int m7z_file_impl::select(int index)
+{
+	file_entry const &entry = m_entries[index];
+	m_curr_file_idx = index;
+	m_curr_is_dir = entry.is_dir;
+	m_curr_name = entry.name;
+	m_curr_length = entry.length;
+	m_curr_crc = entry.crc;
+	return index;
+}
+
+
+/*-------------------------------------------------
+    memory_used - estimate the memory held by the
+    parsed archive and any cached solid block, for
+    the cache budget
+-------------------------------------------------*/
+
+std::size_t m7z_file_impl::memory_used() const
+{
+	std::size_t result = sizeof(*this) + m_out_buffer_size + (m_entries.size() * (sizeof(file_entry) + sizeof(CSzFileItem)));
+	for (file_entry const &entry : m_entries)
+		result += entry.name.length() * 5;
+	return result + ((m_crc_index.size() + m_name_index.size() + m_partial_index.size()) * 4 * sizeof(void *));
+}
+
+
+/*-------------------------------------------------
+    search - find the first file in archive order
+    matching a CRC and/or name
+-------------------------------------------------*/
+
+int m7z_file_impl::search(std::uint32_t crc)
+{
+	int found = -1;
+	auto const range = m_crc_index.equal_range(crc);
+	for (auto it = range.first; it != range.second; ++it)
+		if ((found < 0) || (it->second < found))
+			found = it->second;
+	return (found >= 0) ? select(found) : -1;
+}
+
+int m7z_file_impl::search(const std::string &filename, bool partialpath)
+{
+	std::string lowername(filename);
+	std::transform(lowername.begin(), lowername.end(), lowername.begin(), [] (char ch) { return char(std::tolower(std::uint8_t(ch))); });
+
+	int found = -1;
+	auto const range = m_name_index.equal_range(lowername);
+	for (auto it = range.first; it != range.second; ++it)
+		if ((found < 0) || (it->second < found))
+			found = it->second;
+	if (partialpath)
+	{
+		auto const partialrange = m_partial_index.equal_range(lowername);
+		for (auto it = partialrange.first; it != partialrange.second; ++it)
+			if ((found < 0) || (it->second < found))
+				found = it->second;
 	}
+	return (found >= 0) ? select(found) : -1;
+}
 
-	return -1;
+int m7z_file_impl::search(std::uint32_t crc, const std::string &filename, bool partialpath)
+{
+	int found = -1;
+	auto const range = m_crc_index.equal_range(crc);
+	for (auto it = range.first; it != range.second; ++it)
+		if (((found < 0) || (it->second < found)) && name_matches(it->second, filename, partialpath))
+			found = it->second;
+	return (found >= 0) ? select(found) : -1;
 }
 
 
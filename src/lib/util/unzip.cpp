@@ -17,9 +17,12 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cstring>
 #include <cstdlib>
+#include <list>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -96,7 +99,11 @@ public:
 		, m_length(0)
 		, m_ecd()
 		, m_cd()
-		, m_cd_pos(0)
+		, m_entries()
+		, m_crc_index()
+		, m_name_index()
+		, m_partial_index()
+		, m_next_entry(0)
 		, m_header()
 		, m_curr_is_dir(false)
 		, m_curr_name()
@@ -109,13 +116,14 @@ public:
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
 		{
 			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
+				s_cache_bytes -= result->memory_used();
 				return result;
 			}
 		}
@@ -126,7 +134,8 @@ public:
 	{
 		// clear call cache entries
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		s_cache.clear();
+		s_cache_bytes = 0;
 	}
 
 	archive_file::error initialize()
@@ -150,34 +159,26 @@ public:
 		if ((filerr != osd_file::error::NONE) || (read_length != m_ecd.cd_size))
 			return (filerr == osd_file::error::NONE) ? archive_file::error::FILE_TRUNCATED : archive_file::error::FILE_ERROR;
 
+		// index it so lookups don't need to walk it again
+		try { index_central_directory(); }
+		catch (...) { return archive_file::error::OUT_OF_MEMORY; }
+
 		return archive_file::error::NONE;
 	}
 
 	int first_file()
 	{
-		m_cd_pos = 0;
-		return search(0, std::string(), false, false, false);
+		m_next_entry = 0;
+		return next_file();
 	}
 	int next_file()
 	{
-		return search(0, std::string(), false, false, false);
+		return (m_next_entry < m_entries.size()) ? select(m_next_entry) : -1;
 	}
 
-	int search(std::uint32_t crc)
-	{
-		m_cd_pos = 0;
-		return search(crc, std::string(), true, false, false);
-	}
-	int search(const std::string &filename, bool partialpath)
-	{
-		m_cd_pos = 0;
-		return search(0, filename, false, true, partialpath);
-	}
-	int search(std::uint32_t crc, const std::string &filename, bool partialpath)
-	{
-		m_cd_pos = 0;
-		return search(crc, filename, true, true, partialpath);
-	}
+	int search(std::uint32_t crc);
+	int search(const std::string &filename, bool partialpath);
+	int search(std::uint32_t crc, const std::string &filename, bool partialpath);
 
 	bool current_is_directory() const { return m_curr_is_dir; }
 	const std::string &current_name() const { return m_curr_name; }
@@ -185,6 +186,7 @@ public:
 	std::uint32_t current_crc() const { return m_header.crc; }
 
 	archive_file::error decompress(void *buffer, std::uint32_t length);
+	archive_file::error stored_location(std::string &filename, std::uint64_t &offset);
 
 private:
 	zip_file_impl(const zip_file_impl &) = delete;
@@ -192,7 +194,11 @@ private:
 	zip_file_impl &operator=(const zip_file_impl &) = delete;
 	zip_file_impl &operator=(zip_file_impl &&) = delete;
 
-	int search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath);
+	// central directory index
+	void index_central_directory();
+	bool name_matches(std::size_t index, const std::string &search_filename, bool partialpath) const;
+	int select(std::size_t index);
+	std::size_t memory_used() const;
 
 	archive_file::error reopen()
 	{
@@ -252,9 +258,22 @@ private:
 		std::uint32_t   rawlength;              // length of the raw data
 	};
 
+	// one parsed central directory entry
+	struct cd_entry
+	{
+		std::uint32_t   offset;                 // offset of the entry within the central directory
+		std::uint32_t   crc;                    // crc-32
+		bool            is_dir;                 // entry is a directory
+		std::string     name;                   // filename, without a trailing slash for directories
+	};
+
+	typedef std::unordered_multimap<std::uint32_t, std::size_t> crc_index;
+	typedef std::unordered_multimap<std::string, std::size_t> name_index;
+
 	static constexpr std::size_t        DECOMPRESS_BUFSIZE = 16384;
-	static constexpr std::size_t        CACHE_SIZE = 8; // number of open files to cache
-	static std::array<ptr, CACHE_SIZE>  s_cache;
+	static constexpr std::size_t        CACHE_BUDGET = 32 * 1024 * 1024; // memory closed files may keep cached
+	static std::list<ptr>               s_cache;
+	static std::size_t                  s_cache_bytes;
 	static std::mutex                   s_cache_mutex;
 
 	const std::string           m_filename;                 // copy of ZIP filename (for caching)
@@ -264,7 +283,11 @@ private:
 	ecd                         m_ecd;                      // end of central directory
 
 	std::vector<std::uint8_t>   m_cd;                       // central directory raw data
-	std::uint32_t               m_cd_pos;                   // position in central directory
+	std::vector<cd_entry>       m_entries;                  // parsed central directory entries
+	crc_index                   m_crc_index;                // CRC -> entry index
+	name_index                  m_name_index;               // lowercase filename -> entry index
+	name_index                  m_partial_index;            // lowercase trailing path components -> entry index
+	std::size_t                 m_next_entry;               // next entry for iteration
 	file_header                 m_header;                   // current file header
 	bool                        m_curr_is_dir;              // current file is directory
 	std::string                 m_curr_name;                // current file name
@@ -301,6 +324,7 @@ public:
 	virtual std::uint32_t current_crc() const override { return m_impl->current_crc(); }
 
 	virtual error decompress(void *buffer, std::uint32_t length) override { return m_impl->decompress(buffer, length); }
+	virtual error stored_location(std::string &filename, std::uint64_t &offset) override { return m_impl->stored_location(filename, offset); }
 
 private:
 	zip_file_impl::ptr m_impl;
@@ -348,8 +372,9 @@ inline std::uint32_t read_dword(std::uint8_t const *buf)
     GLOBAL VARIABLES
 ***************************************************************************/
 
-/** @brief  The zip cache[ zip cache size]. */
-std::array<zip_file_impl::ptr, zip_file_impl::CACHE_SIZE> zip_file_impl::s_cache;
+/** @brief  The zip cache, most recently closed first. */
+std::list<zip_file_impl::ptr> zip_file_impl::s_cache;
+std::size_t zip_file_impl::s_cache_bytes = 0;
 std::mutex zip_file_impl::s_cache_mutex;
 
 
@@ -374,21 +399,17 @@ void zip_file_impl::close(ptr &&zip)
 	// close the open files
 	zip->m_file.reset();
 
-	// find the first NULL entry in the cache
+	// place us at the top of the cache
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
-			break;
-
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
-		s_cache[--cachenum].reset();
+	s_cache_bytes += zip->memory_used();
+	s_cache.push_front(std::move(zip));
 
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(zip);
+	// free the least recently used entries until we fit the budget again
+	while ((s_cache_bytes > CACHE_BUDGET) && !s_cache.empty())
+	{
+		s_cache_bytes -= s_cache.back()->memory_used();
+		s_cache.pop_back();
+	}
 }
 
 
@@ -397,71 +418,157 @@ void zip_file_impl::close(ptr &&zip)
 ***************************************************************************/
 
 /*-------------------------------------------------
-    zip_file_first_entry - return the first entry
-    in the ZIP
+    index_central_directory - parse the central
+    directory once, building lookup tables by CRC
+    and by name
 -------------------------------------------------*/
 
+void zip_file_impl::index_central_directory()
+{
+	std::uint32_t pos = 0;
+	while ((pos + ZIPCFN) <= m_ecd.cd_size)
+	{
+		// make sure we have enough data
+		std::uint8_t const *const raw = &m_cd[0] + pos;
+		std::uint16_t const filename_length = read_word(raw + ZIPCFNL);
+		std::uint32_t const rawlength = ZIPCFN + filename_length + read_word(raw + ZIPCXTL) + read_word(raw + ZIPCCML);
+		if ((pos + rawlength) > m_ecd.cd_size)
+			break;
+
+		// record the entry
+		cd_entry entry;
+		char const *const filename = reinterpret_cast<const char *>(raw + ZIPCFN);
+		entry.offset = pos;
+		entry.crc = read_dword(raw + ZIPCCRC);
+		entry.is_dir = (filename_length > 0) && (filename[filename_length - 1] == '/');
+		entry.name.assign(filename, filename_length - (entry.is_dir ? 1 : 0));
+		m_entries.emplace_back(std::move(entry));
+		pos += rawlength;
+	}
+
+	// directories are never returned by searches, so leave them out of the indexes
+	m_crc_index.reserve(m_entries.size());
+	m_name_index.reserve(m_entries.size());
+	for (std::size_t index = 0; index < m_entries.size(); index++)
+	{
+		cd_entry const &entry = m_entries[index];
+		if (entry.is_dir)
+			continue;
+
+		std::string lowername(entry.name);
+		std::transform(lowername.begin(), lowername.end(), lowername.begin(), [] (char ch) { return char(std::tolower(std::uint8_t(ch))); });
+		m_crc_index.emplace(entry.crc, index);
+		for (std::string::size_type sep = lowername.find('/'); sep != std::string::npos; sep = lowername.find('/', sep + 1))
+			m_partial_index.emplace(lowername.substr(sep + 1), index);
+		m_name_index.emplace(std::move(lowername), index);
+	}
+}
+
+
 /*-------------------------------------------------
-    zip_file_next_entry - return the next entry
-    in the ZIP
+    name_matches - check whether an entry matches
+    the name being searched for
 -------------------------------------------------*/
 
-int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath)
+bool zip_file_impl::name_matches(std::size_t index, const std::string &search_filename, bool partialpath) const
 {
-	// if we're at or past the end, we're done
-	std::string filename;
-	while ((m_cd_pos + ZIPCFN) <= m_ecd.cd_size)
-	{
-		// extract file header info
-		std::uint8_t const *const raw = &m_cd[0] + m_cd_pos;
-		m_header.signature           = read_dword(raw + ZIPCENSIG);
-		m_header.version_created     = read_word (raw + ZIPCVER);
-		m_header.version_needed      = read_word (raw + ZIPCVXT);
-		m_header.bit_flag            = read_word (raw + ZIPCFLG);
-		m_header.compression         = read_word (raw + ZIPCMTHD);
-		m_header.file_time           = read_word (raw + ZIPCTIM);
-		m_header.file_date           = read_word (raw + ZIPCDAT);
-		m_header.crc                 = read_dword(raw + ZIPCCRC);
-		m_header.compressed_length   = read_dword(raw + ZIPCSIZ);
-		m_header.uncompressed_length = read_dword(raw + ZIPCUNC);
-		m_header.filename_length     = read_word (raw + ZIPCFNL);
-		m_header.extra_field_length  = read_word (raw + ZIPCXTL);
-		m_header.file_comment_length = read_word (raw + ZIPCCML);
-		m_header.start_disk_number   = read_word (raw + ZIPDSK);
-		m_header.internal_attributes = read_word (raw + ZIPINT);
-		m_header.external_attributes = read_dword(raw + ZIPEXT);
-		m_header.local_header_offset = read_dword(raw + ZIPOFST);
-		m_header.filename            = reinterpret_cast<const char *>(raw + ZIPCFN);
+	std::string const &filename = m_entries[index].name;
+	auto const partialoffset(filename.length() - search_filename.length());
+	bool const partialpossible((filename.length() > search_filename.length()) && (filename[partialoffset - 1] == '/'));
+	return !core_stricmp(search_filename.c_str(), filename.c_str()) ||
+			(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), filename.c_str() + partialoffset));
+}
 
-		// make sure we have enough data
-		std::uint32_t const rawlength = ZIPCFN + m_header.filename_length + m_header.extra_field_length + m_header.file_comment_length;
-		if ((m_cd_pos + rawlength) > m_ecd.cd_size)
-			break;
 
-		// advance the position
-		m_cd_pos += rawlength;
+/*-------------------------------------------------
+    select - make an entry current, extracting its
+    full header from the central directory
+-------------------------------------------------*/
 
-		// copy the filename filename
-		bool const is_dir((m_header.filename_length > 0) && (m_header.filename[m_header.filename_length - 1] == '/'));
-		filename.assign(m_header.filename, m_header.filename_length - (is_dir ? 1 : 0));
+int zip_file_impl::select(std::size_t index)
+{
+	cd_entry const &entry = m_entries[index];
+	std::uint8_t const *const raw = &m_cd[0] + entry.offset;
+	m_header.signature           = read_dword(raw + ZIPCENSIG);
+	m_header.version_created     = read_word (raw + ZIPCVER);
+	m_header.version_needed      = read_word (raw + ZIPCVXT);
+	m_header.bit_flag            = read_word (raw + ZIPCFLG);
+	m_header.compression         = read_word (raw + ZIPCMTHD);
+	m_header.file_time           = read_word (raw + ZIPCTIM);
+	m_header.file_date           = read_word (raw + ZIPCDAT);
+	m_header.crc                 = read_dword(raw + ZIPCCRC);
+	m_header.compressed_length   = read_dword(raw + ZIPCSIZ);
+	m_header.uncompressed_length = read_dword(raw + ZIPCUNC);
+	m_header.filename_length     = read_word (raw + ZIPCFNL);
+	m_header.extra_field_length  = read_word (raw + ZIPCXTL);
+	m_header.file_comment_length = read_word (raw + ZIPCCML);
+	m_header.start_disk_number   = read_word (raw + ZIPDSK);
+	m_header.internal_attributes = read_word (raw + ZIPINT);
+	m_header.external_attributes = read_dword(raw + ZIPEXT);
+	m_header.local_header_offset = read_dword(raw + ZIPOFST);
+	m_header.filename            = reinterpret_cast<const char *>(raw + ZIPCFN);
+
+	m_curr_is_dir = entry.is_dir;
+	m_curr_name = entry.name;
+	m_next_entry = index + 1;
+	return 0;
+}
 
-		// check to see if it matches query
-		bool const crcmatch(search_crc == m_header.crc);
-		auto const partialoffset(filename.length() - search_filename.length());
-		bool const partialpossible((filename.length() > search_filename.length()) && (filename[partialoffset - 1] == '/'));
-		const bool namematch(
-				!core_stricmp(search_filename.c_str(), filename.c_str()) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), filename.c_str() + partialoffset)));
 
-		bool const found = ((!matchcrc && !matchname) || !is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
-		if (found)
-		{
-			m_curr_is_dir = is_dir;
-			m_curr_name = std::move(filename);
-			return 0;
-		}
+/*-------------------------------------------------
+    memory_used - estimate the memory held by the
+    parsed archive, for the cache budget
+-------------------------------------------------*/
+
+std::size_t zip_file_impl::memory_used() const
+{
+	std::size_t result = sizeof(*this) + m_cd.size() + (m_entries.size() * sizeof(cd_entry));
+	for (cd_entry const &entry : m_entries)
+		result += entry.name.length() * 3;
+	return result + ((m_crc_index.size() + m_name_index.size() + m_partial_index.size()) * 4 * sizeof(void *));
+}
+
+
+/*-------------------------------------------------
+    search - find the first entry in central
+    directory order matching a CRC and/or name
+-------------------------------------------------*/
+
+int zip_file_impl::search(std::uint32_t crc)
+{
+	std::size_t found = m_entries.size();
+	auto const range = m_crc_index.equal_range(crc);
+	for (auto it = range.first; it != range.second; ++it)
+		found = (std::min)(found, it->second);
+	return (found < m_entries.size()) ? select(found) : -1;
+}
+
+int zip_file_impl::search(const std::string &filename, bool partialpath)
+{
+	std::string lowername(filename);
+	std::transform(lowername.begin(), lowername.end(), lowername.begin(), [] (char ch) { return char(std::tolower(std::uint8_t(ch))); });
+
+	std::size_t found = m_entries.size();
+	auto const range = m_name_index.equal_range(lowername);
+	for (auto it = range.first; it != range.second; ++it)
+		found = (std::min)(found, it->second);
+	if (partialpath)
+	{
+		auto const partialrange = m_partial_index.equal_range(lowername);
+		for (auto it = partialrange.first; it != partialrange.second; ++it)
+			found = (std::min)(found, it->second);
 	}
-	return -1;
+	return (found < m_entries.size()) ? select(found) : -1;
+}
+
+int zip_file_impl::search(std::uint32_t crc, const std::string &filename, bool partialpath)
+{
+	std::size_t found = m_entries.size();
+	auto const range = m_crc_index.equal_range(crc);
+	for (auto it = range.first; it != range.second; ++it)
+		if ((it->second < found) && name_matches(it->second, filename, partialpath))
+			found = it->second;
+	return (found < m_entries.size()) ? select(found) : -1;
 }
 
 
@@ -604,6 +711,37 @@ archive_file::error zip_file_impl::read_ecd()
 }
 
 
+/*-------------------------------------------------
+    stored_location - return the archive filename
+    and offset of the current file's data if it
+    is stored without compression or encryption
+-------------------------------------------------*/
+
+/**
+ * @fn  archive_file::error zip_file_impl::stored_location(std::string &filename, std::uint64_t &offset)
+ *
+ * @brief   Locates stored file data within the archive.
+ *
+ * @param [out]     filename    Receives the archive filename.
+ * @param [out]     offset      Receives the offset of the data.
+ *
+ * @return  UNSUPPORTED if the data is compressed, encrypted or on another disk.
+ */
+
+archive_file::error zip_file_impl::stored_location(std::string &filename, std::uint64_t &offset)
+{
+	if (m_header.compression != 0 || (m_header.bit_flag & 0x0001) || m_header.start_disk_number != m_ecd.disk_number || m_header.compressed_length != m_header.uncompressed_length)
+		return archive_file::error::UNSUPPORTED;
+
+	auto const ziperr = get_compressed_data_offset(offset);
+	if (ziperr != archive_file::error::NONE)
+		return ziperr;
+
+	filename = m_filename;
+	return archive_file::error::NONE;
+}
+
+
 /*-------------------------------------------------
     get_compressed_data_offset - return the
     offset of the compressed data
@@ -81,6 +81,9 @@ public:
 
 	// decompress the most recently found file in the ZIP
 	virtual error decompress(void *buffer, std::uint32_t length) = 0;
+
+	// locate the most recently found file's data if it is stored uncompressed, so it can be used in place
+	virtual error stored_location(std::string &filename, std::uint64_t &offset) = 0;
 };
 
 } // namespace util
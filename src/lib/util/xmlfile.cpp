@@ -587,7 +587,8 @@ xml_attribute_node *xml_set_attribute_float(xml_data_node *node, const char *nam
 
 const char *xml_normalize_string(const char *string)
 {
-	static char buffer[1024];
+	// one buffer per thread, so XML can be generated on several threads at once
+	static thread_local char buffer[1024];
 	char *d = &buffer[0];
 
 	if (string != nullptr)
@@ -272,7 +272,7 @@ public:
 
 public:
 	model2_renderer(model2_state& state)
-		: poly_manager<float, m2_poly_extra_data, 4, 4000>(state.machine())
+		: poly_manager<float, m2_poly_extra_data, 4, 4000>(state.machine(), POLYFLAG_TILE_BINNING)
 		, m_state(state)
 		, m_destmap(state.m_screen->width(), state.m_screen->height())
 	{
@@ -44,6 +44,7 @@
 
 #include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -323,6 +324,72 @@ osd_file::error osd_file::remove(std::string const &filename)
 }
 
 
+//============================================================
+//  osd_file::rename
+//============================================================
+
+osd_file::error osd_file::rename(std::string const &oldname, std::string const &newname)
+{
+	if (::rename(oldname.c_str(), newname.c_str()) < 0)
+		return errno_to_file_error(errno);
+	else
+		return error::NONE;
+}
+
+
+//============================================================
+//  osd_file::map
+//============================================================
+
+osd_file::error osd_file::map(std::string const &path, std::uint64_t offset, std::uint32_t length, void *&base)
+{
+	if (length == 0)
+		return error::INVALID_ACCESS;
+
+	// convert the path into something compatible
+	std::string dst(path);
+	for (auto it = dst.begin(); it != dst.end(); ++it)
+		*it = (INVPATHSEPCH == *it) ? PATHSEPCH : *it;
+	osd_subst_env(dst, dst);
+
+	int const fd = ::open(dst.c_str(), O_RDONLY);
+	if (fd < 0)
+		return errno_to_file_error(errno);
+
+	// touching pages past the end of the file raises SIGBUS, so check the range first
+	struct stat st;
+	if (::fstat(fd, &st) < 0 || (std::uint64_t(st.st_size) < offset + length))
+	{
+		::close(fd);
+		return error::INVALID_ACCESS;
+	}
+
+	// mappings have to start on a page boundary
+	std::uint64_t const pagesize = std::uint64_t(::sysconf(_SC_PAGESIZE));
+	std::uint64_t const delta = offset % pagesize;
+	void *const mapping = ::mmap(nullptr, size_t(length + delta), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, off_t(offset - delta));
+	int const err = errno;
+	::close(fd);
+	if (mapping == MAP_FAILED)
+		return errno_to_file_error(err);
+
+	base = reinterpret_cast<std::uint8_t *>(mapping) + delta;
+	return error::NONE;
+}
+
+
+//============================================================
+//  osd_file::unmap
+//============================================================
+
+void osd_file::unmap(void *base, std::uint32_t length)
+{
+	std::uintptr_t const pagesize = std::uintptr_t(::sysconf(_SC_PAGESIZE));
+	std::uintptr_t const delta = reinterpret_cast<std::uintptr_t>(base) % pagesize;
+	::munmap(reinterpret_cast<std::uint8_t *>(base) - delta, size_t(length + delta));
+}
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -355,6 +422,7 @@ osd_directory_entry *osd_stat(const std::string &path)
 	result->name = reinterpret_cast<char *>(result) + sizeof(*result);
 	result->type = S_ISDIR(st.st_mode) ? ENTTYPE_DIR : ENTTYPE_FILE;
 	result->size = std::uint64_t(std::make_unsigned_t<decltype(st.st_size)>(st.st_size));
+	result->last_modified = INT64(st.st_mtime);
 
 	return result;
 }
@@ -163,6 +163,38 @@ osd_file::error osd_file::remove(std::string const &filename)
 }
 
 
+//============================================================
+//  osd_file::rename
+//============================================================
+
+osd_file::error osd_file::rename(std::string const &oldname, std::string const &newname)
+{
+	// std::rename may refuse to replace an existing file, so clear the way first
+	std::remove(newname.c_str());
+	return (std::rename(oldname.c_str(), newname.c_str()) != 0) ? error::FAILURE : error::NONE;
+}
+
+
+//============================================================
+//  osd_file::map
+//============================================================
+
+osd_file::error osd_file::map(std::string const &path, std::uint64_t offset, std::uint32_t length, void *&base)
+{
+	// there is no standard way of doing this; callers fall back to reading
+	return error::FAILURE;
+}
+
+
+//============================================================
+//  osd_file::unmap
+//============================================================
+
+void osd_file::unmap(void *base, std::uint32_t length)
+{
+}
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -202,6 +234,7 @@ osd_directory_entry *osd_stat(const std::string &path)
 	result->name = (char *)(result + 1);
 	result->type = ENTTYPE_NONE;
 	result->size = 0;
+	result->last_modified = 0;
 
 	FILE *f = std::fopen(path.c_str(), "rb");
 	if (f != nullptr)
@@ -300,6 +300,92 @@ osd_file::error osd_file::remove(std::string const &filename)
 
 
 
+//============================================================
+//  osd_file::rename
+//============================================================
+
+osd_file::error osd_file::rename(std::string const &oldname, std::string const &newname)
+{
+	TCHAR *t_oldname = tstring_from_utf8(oldname.c_str());
+	TCHAR *t_newname = tstring_from_utf8(newname.c_str());
+	error filerr = error::NONE;
+	if (!t_oldname || !t_newname)
+		filerr = error::OUT_OF_MEMORY;
+	else if (!MoveFileEx(t_oldname, t_newname, MOVEFILE_REPLACE_EXISTING))
+		filerr = win_error_to_file_error(GetLastError());
+
+	if (t_newname)
+		osd_free(t_newname);
+	if (t_oldname)
+		osd_free(t_oldname);
+	return filerr;
+}
+
+
+//============================================================
+//  osd_file::map
+//============================================================
+
+osd_file::error osd_file::map(std::string const &path, std::uint64_t offset, std::uint32_t length, void *&base)
+{
+	if (length == 0)
+		return error::INVALID_ACCESS;
+
+	TCHAR *t_path = tstring_from_utf8(path.c_str());
+	osd_disposer<TCHAR> t_path_disposer(t_path);
+	if (!t_path)
+		return error::OUT_OF_MEMORY;
+
+	HANDLE file = CreateFile(t_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+	if (INVALID_HANDLE_VALUE == file)
+		return win_error_to_file_error(GetLastError());
+
+	// make sure the range lies within the file
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || (std::uint64_t(size.QuadPart) < offset + length))
+	{
+		CloseHandle(file);
+		return error::INVALID_ACCESS;
+	}
+
+	// the view keeps the mapping and file alive, so both handles can be closed afterwards
+	HANDLE mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	DWORD err = GetLastError();
+	CloseHandle(file);
+	if (mapping == NULL)
+		return win_error_to_file_error(err);
+
+	// views have to start on an allocation granularity boundary
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	std::uint64_t const delta = offset % info.dwAllocationGranularity;
+	std::uint64_t const start = offset - delta;
+	void *view = MapViewOfFile(mapping, FILE_MAP_COPY, DWORD(start >> 32), DWORD(start), SIZE_T(length + delta));
+	err = GetLastError();
+	CloseHandle(mapping);
+	if (view == NULL)
+		return win_error_to_file_error(err);
+
+	base = reinterpret_cast<std::uint8_t *>(view) + delta;
+	return error::NONE;
+}
+
+
+
+//============================================================
+//  osd_file::unmap
+//============================================================
+
+void osd_file::unmap(void *base, std::uint32_t length)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	std::uintptr_t const delta = reinterpret_cast<std::uintptr_t>(base) % info.dwAllocationGranularity;
+	UnmapViewOfFile(reinterpret_cast<std::uint8_t *>(base) - delta);
+}
+
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -388,6 +474,7 @@ osd_directory_entry *osd_stat(const std::string &path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = win_attributes_to_entry_type(find_data.dwFileAttributes);
 	result->size = find_data.nFileSizeLow | ((UINT64) find_data.nFileSizeHigh << 32);
+	result->last_modified = win_filetime_to_seconds(find_data.ftLastWriteTime);
 
 	return result;
 }
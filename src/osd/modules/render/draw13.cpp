@@ -757,33 +757,43 @@ texture_info::~texture_info()
 //  texture_set_data
 //============================================================
 
-void texture_info::set_data(const render_texinfo &texsource, const UINT32 flags)
+void texture_info::set_data(const render_texinfo &texsource, const UINT32 flags, const bool partial)
 {
+	// passthrough textures are plain copies, so if we hold the previous contents
+	// only the rows that changed since then need to be sent
+	SDL_Rect band = { 0, 0, (int)texsource.width, (int)texsource.height };
+	if (partial && m_copyinfo->blitter->m_is_passthrough && !texsource.dirty.empty())
+	{
+		band.y = MAX(texsource.dirty.min_y, 0);
+		band.h = MIN(texsource.dirty.max_y + 1, (int)texsource.height) - band.y;
+	}
+
 	m_copyinfo->time -= osd_ticks();
 	if (m_sdl_access == SDL_TEXTUREACCESS_STATIC)
 	{
 		if ( m_copyinfo->blitter->m_is_passthrough )
 		{
-			m_pixels = texsource.base;
 			m_pitch = m_texinfo.rowpixels * m_copyinfo->blitter->m_dest_bpp;
+			m_pixels = (UINT8 *) texsource.base + band.y * m_pitch;
+			SDL_UpdateTexture(m_texture_id, &band, m_pixels, m_pitch);
 		}
 		else
 		{
 			m_pitch = m_setup.rotwidth * m_copyinfo->blitter->m_dest_bpp;
 			m_copyinfo->blitter->texop(this, &texsource);
+			SDL_UpdateTexture(m_texture_id, nullptr, m_pixels, m_pitch);
 		}
-		SDL_UpdateTexture(m_texture_id, nullptr, m_pixels, m_pitch);
 	}
 	else
 	{
-		SDL_LockTexture(m_texture_id, nullptr, (void **) &m_pixels, &m_pitch);
 		if ( m_copyinfo->blitter->m_is_passthrough )
 		{
-			UINT8 *src = (UINT8 *) texsource.base;
-			UINT8 *dst = (UINT8 *) m_pixels;
+			SDL_LockTexture(m_texture_id, &band, (void **) &m_pixels, &m_pitch);
 			int spitch = texsource.rowpixels * m_copyinfo->blitter->m_dest_bpp;
+			UINT8 *src = (UINT8 *) texsource.base + band.y * spitch;
+			UINT8 *dst = (UINT8 *) m_pixels;
 			int num = texsource.width * m_copyinfo->blitter->m_dest_bpp;
-			int h = texsource.height;
+			int h = band.h;
 			while (h--) {
 				memcpy(dst, src, num);
 				src += spitch;
@@ -791,7 +801,10 @@ void texture_info::set_data(const render_texinfo &texsource, const UINT32 flags)
 			}
 		}
 		else
+		{
+			SDL_LockTexture(m_texture_id, nullptr, (void **) &m_pixels, &m_pitch);
 			m_copyinfo->blitter->texop(this, &texsource);
+		}
 		SDL_UnlockTexture(m_texture_id);
 	}
 	m_copyinfo->time += osd_ticks();
@@ -948,9 +961,11 @@ texture_info * renderer_sdl1::texture_update(const render_primitive &prim)
 	{
 		if (prim.texture.base != nullptr && texture->texinfo().seqid != prim.texture.seqid)
 		{
+			// the texture reports what changed since the sequence number before this one
+			bool partial = (prim.texture.seqid == texture->texinfo().seqid + 1);
 			texture->texinfo().seqid = prim.texture.seqid;
 			// if we found it, but with a different seqid, copy the data
-			texture->set_data(prim.texture, prim.flags);
+			texture->set_data(prim.texture, prim.flags, partial);
 		}
 
 	}
@@ -61,7 +61,7 @@ public:
 	texture_info(renderer_sdl1 *renderer, const render_texinfo &texsource, const quad_setup_data &setup, const UINT32 flags);
 	~texture_info();
 
-	void set_data(const render_texinfo &texsource, const UINT32 flags);
+	void set_data(const render_texinfo &texsource, const UINT32 flags, const bool partial);
 	void render_quad(const render_primitive &prim, const int x, const int y);
 	bool matches(const render_primitive &prim, const quad_setup_data &setup);
 
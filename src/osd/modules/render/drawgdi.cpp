@@ -18,6 +18,10 @@ renderer_gdi::~renderer_gdi()
 	// free the bitmap memory
 	if (m_bmdata != nullptr)
 		global_free_array(m_bmdata);
+
+	// and the band rendering queue
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 //============================================================
@@ -80,7 +84,7 @@ int renderer_gdi::draw(const int update)
 
 	// draw the primitives to the bitmap
 	window().m_primlist->acquire_lock();
-	software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window().m_primlist, m_bmdata, width, height, pitch);
+	software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window().m_primlist, m_bmdata, width, height, pitch, m_work_queue);
 	window().m_primlist->release_lock();
 
 	// fill in bitmap-specific info
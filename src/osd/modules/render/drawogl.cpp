@@ -268,7 +268,7 @@ static int glsl_shader_feature = GLSL_SHADER_FEAT_PLAIN;
 //  Textures
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags);
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags, bool partial);
 
 //============================================================
 //  Static Variables
@@ -2310,12 +2310,48 @@ static inline void copyline_yuy16_to_argb(UINT32 *dst, const UINT16 *src, int wi
 	}
 }
 
+//============================================================
+//  texture_upload_rows
+//============================================================
+
+static void texture_upload_rows(ogl_texture_info *texture, bool full, int miny, int maxy)
+{
+	if (full)
+	{
+		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+	}
+
+	// send just the band of rows that changed
+	else if (texture->nocopy)
+	{
+		glTexSubImage2D(texture->texTarget, 0, 0, miny, texture->rawwidth, maxy - miny + 1,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data + miny * texture->texinfo.rowpixels);
+	}
+	else
+	{
+		int y0 = miny * texture->yprescale + texture->borderpix;
+		glTexSubImage2D(texture->texTarget, 0, 0, y0, texture->rawwidth, (maxy - miny + 1) * texture->yprescale,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data + y0 * texture->rawwidth);
+	}
+}
+
 //============================================================
 //  texture_set_data
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags)
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags, bool partial)
 {
+	// if we hold the previous contents, only the rows that changed since then
+	// need to be converted and uploaded; mapped PBOs are always refilled
+	int miny = 0, maxy = (int)texsource->height - 1;
+	if (partial && texture->type != TEXTURE_TYPE_DYNAMIC && !texsource->dirty.empty())
+	{
+		miny = MAX(texsource->dirty.min_y, 0);
+		maxy = MIN(texsource->dirty.max_y, (int)texsource->height - 1);
+	}
+	bool full = (miny == 0 && maxy == (int)texsource->height - 1);
+
 	if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
 		assert(texture->pbo);
@@ -2333,7 +2369,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 	}
 
 	// always fill non-wrapping textures with an extra pixel on the top
-	if (texture->borderpix)
+	if (texture->borderpix && full)
 	{
 		memset(texture->data, 0,
 				(texsource->width * texture->xprescale + 2) * sizeof(UINT32));
@@ -2345,7 +2381,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 		int y, y2;
 		UINT8 *dst;
 
-		for (y = 0; y < texsource->height; y++)
+		for (y = miny; y <= maxy; y++)
 		{
 			for (y2 = 0; y2 < texture->yprescale; y2++)
 			{
@@ -2382,7 +2418,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 	}
 
 	// always fill non-wrapping textures with an extra pixel on the bottom
-	if (texture->borderpix)
+	if (texture->borderpix && full)
 	{
 		memset((UINT8 *)texture->data +
 				(texsource->height + 1) * texture->rawwidth * sizeof(UINT32),
@@ -2401,8 +2437,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		texture_upload_rows(texture, full, miny, maxy);
 	}
 	else if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
@@ -2428,8 +2463,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		texture_upload_rows(texture, full, miny, maxy);
 	}
 }
 
@@ -2692,10 +2726,12 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 		{
 			if (prim->texture.base != nullptr && texture->texinfo.seqid != prim->texture.seqid)
 			{
+				// the texture reports what changed since the sequence number before this one
+				bool partial = (prim->texture.seqid == texture->texinfo.seqid + 1);
 				texture->texinfo.seqid = prim->texture.seqid;
 
 				// if we found it, but with a different seqid, copy the data
-				texture_set_data(texture, &prim->texture, prim->flags);
+				texture_set_data(texture, &prim->texture, prim->flags, partial);
 				texBound=1;
 			}
 		}
@@ -32,6 +32,7 @@ public:
 		, m_last_vofs(0)
 		, m_blit_dim(0, 0)
 		, m_last_dim(0, 0)
+		, m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
 	{
 	}
 	virtual ~renderer_sdl2();
@@ -69,6 +70,9 @@ private:
 	int                 m_last_vofs;
 	osd_dim             m_blit_dim;
 	osd_dim             m_last_dim;
+
+	// software rendering is split into bands drawn on this queue
+	osd_work_queue      *m_work_queue;
 };
 
 struct sdl_scale_mode
@@ -59,11 +59,9 @@ typedef void *PVOID;
 //============================================================
 
 #if KEEP_STATISTICS
-#define add_to_stat(v,x)        do { (v) += (x); } while (0)
 #define begin_timing(v)         do { (v) -= get_profile_ticks(); } while (0)
 #define end_timing(v)           do { (v) += get_profile_ticks(); } while (0)
 #else
-#define add_to_stat(v,x)        do { } while (0)
 #define begin_timing(v)         do { } while (0)
 #define end_timing(v)           do { } while (0)
 #endif
@@ -94,15 +92,27 @@ static void spin_while_not(const volatile _AtomType * volatile atom, const _Main
 //  TYPE DEFINITIONS
 //============================================================
 
+// each thread owns a deque of pending items; it takes work from its own
+// deque first and steals from the others when that runs dry
+struct work_deque
+{
+	std::atomic<INT32>  lock;           // spin lock; only ever held for a few instructions
+	std::atomic<INT32>  count;          // number of items in the deque
+	osd_work_item *     head;           // next item to process
+	osd_work_item *     tail;           // last item in the deque
+};
+
+
 struct work_thread_info
 {
 	osd_work_queue *    queue;          // pointer back to the queue
 	std::thread *       handle;         // handle to the thread
 	osd_event *         wakeevent;      // wake event for the thread
 	std::atomic<INT32>  active;         // are we actively processing work?
+	std::atomic<INT64>  itemsdone;      // items processed by this thread
+	std::atomic<INT64>  steals;         // items taken from other threads' deques
 
 #if KEEP_STATISTICS
-	INT32               itemsdone;
 	osd_ticks_t         actruntime;
 	osd_ticks_t         runtime;
 	osd_ticks_t         spintime;
@@ -113,11 +123,13 @@ struct work_thread_info
 
 struct osd_work_queue
 {
-	std::mutex          *lock;          // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
+	std::mutex          *lock;          // lock protecting the free list and item events
+	work_deque *        deque;          // per-thread deques of pending items
+	UINT32              deques;         // number of deques
+	std::atomic<UINT32> nextdeque;      // where to start handing out the next batch
 	std::atomic<osd_work_item *> free;  // free list of work items
-	std::atomic<INT32>  items;          // items in the queue
+	std::atomic<INT32>  items;          // items in the queue, including ones being processed
+	std::atomic<INT32>  pending;        // items not yet picked up by a thread
 	std::atomic<INT32>  livethreads;    // number of live threads
 	std::atomic<INT32>  waiting;        // is someone waiting on the queue to complete?
 	std::atomic<INT32>  exiting;        // should the threads exit on their next opportunity?
@@ -126,12 +138,9 @@ struct osd_work_queue
 	work_thread_info *  thread;         // array of thread information
 	osd_event   *       doneevent;      // event signalled when work is complete
 
-#if KEEP_STATISTICS
-	std::atomic<INT32>  itemsqueued;    // total items queued
-	std::atomic<INT32>  setevents;      // number of times we called SetEvent
-	std::atomic<INT32>  extraitems;     // how many extra items we got after the first in the queue loop
-	std::atomic<INT32>  spinloops;      // how many times spinning bought us more items
-#endif
+	std::atomic<INT64>  itemsqueued;    // total items queued
+	std::atomic<INT64>  setevents;      // number of times we woke a thread
+	std::atomic<INT64>  spinloops;      // how many times spinning bought us more items
 };
 
 
@@ -161,6 +170,74 @@ static int effective_num_processors(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
 static bool queue_has_list_items(osd_work_queue *queue);
+static osd_work_item *steal_items(osd_work_queue *queue, work_thread_info *thread, work_deque *own);
+static void free_item_list(osd_work_item *item);
+
+//============================================================
+//  deque_lock/deque_unlock
+//============================================================
+
+static inline void deque_lock(work_deque &deque)
+{
+	while (deque.lock.exchange(1, std::memory_order_acquire) != 0)
+		while (deque.lock.load(std::memory_order_relaxed) != 0)
+			std::this_thread::yield();
+}
+
+static inline void deque_unlock(work_deque &deque)
+{
+	deque.lock.store(0, std::memory_order_release);
+}
+
+//============================================================
+//  deque_push - append a NULL-terminated chain of items
+//============================================================
+
+static void deque_push(work_deque &deque, osd_work_item *first, osd_work_item *last, INT32 count)
+{
+	deque_lock(deque);
+	if (deque.tail != NULL)
+		deque.tail->next = first;
+	else
+		deque.head = first;
+	deque.tail = last;
+	deque.count += count;
+	deque_unlock(deque);
+}
+
+//============================================================
+//  deque_take - remove one item, or half of the items,
+//  from the head of a deque, returning them as a
+//  NULL-terminated chain
+//============================================================
+
+static osd_work_item *deque_take(work_deque &deque, bool half, osd_work_item *&last, INT32 &taken)
+{
+	// cheap check before bothering with the lock
+	taken = 0;
+	if (deque.count.load(std::memory_order_relaxed) == 0)
+		return NULL;
+
+	deque_lock(deque);
+	osd_work_item *first = deque.head;
+	INT32 want = half ? (deque.count + 1) / 2 : 1;
+	last = NULL;
+	for (osd_work_item *item = first; item != NULL && taken < want; item = item->next)
+	{
+		last = item;
+		taken++;
+	}
+	if (last != NULL)
+	{
+		deque.head = last->next;
+		if (deque.head == NULL)
+			deque.tail = NULL;
+		deque.count -= taken;
+		last->next = NULL;
+	}
+	deque_unlock(deque);
+	return (last != NULL) ? first : NULL;
+}
 
 //============================================================
 //  osd_thread_adjust_priority
@@ -210,7 +287,6 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	memset(queue, 0, sizeof(*queue));
 
 	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
 
 	// allocate events for the queue
@@ -237,11 +313,12 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	// clamp to the maximum
 	queue->threads = MIN(threadnum, WORK_MAX_THREADS);
 
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
+	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI);
+	// with no threads at all, slot 0 stands in for whoever runs the items inline
 	if (flags & WORK_QUEUE_FLAG_MULTI)
 		allocthreadnum = queue->threads + 1;
 	else
-		allocthreadnum = queue->threads;
+		allocthreadnum = MAX(queue->threads, 1);
 
 #if KEEP_STATISTICS
 	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
@@ -252,6 +329,13 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 		goto error;
 	memset(queue->thread, 0, allocthreadnum * sizeof(queue->thread[0]));
 
+	// allocate one deque per worker thread; the calling thread only ever steals
+	queue->deques = MAX(queue->threads, 1);
+	queue->deque = (work_deque *)osd_malloc_array(queue->deques * sizeof(queue->deque[0]));
+	if (queue->deque == NULL)
+		goto error;
+	memset(queue->deque, 0, queue->deques * sizeof(queue->deque[0]));
+
 	// iterate over threads
 	for (threadnum = 0; threadnum < queue->threads; threadnum++)
 	{
@@ -400,15 +484,15 @@ void osd_work_queue_free(osd_work_queue *queue)
 		if (queue->flags & WORK_QUEUE_FLAG_MULTI)
 			allocthreadnum = queue->threads + 1;
 		else
-			allocthreadnum = queue->threads;
+			allocthreadnum = MAX(queue->threads, 1);
 
 		// output per-thread statistics
 		for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
 		{
 			work_thread_info *thread = &queue->thread[threadnum];
 			osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-			printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-					threadnum, thread->itemsdone,
+			printf("Thread %d:  items=%9d steals=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
+					threadnum, (INT32)thread->itemsdone, (INT32)thread->steals,
 					(double)thread->runtime * 100.0 / (double)total,
 					(double)thread->actruntime * 100.0 / (double)total,
 					(double)thread->spintime * 100.0 / (double)total,
@@ -418,6 +502,15 @@ void osd_work_queue_free(osd_work_queue *queue)
 #endif
 	}
 
+	// report what the queue did while it was alive
+	if (queue->thread != NULL && queue->itemsqueued != 0)
+	{
+		osd_work_queue_stats stats;
+		osd_work_queue_get_stats(queue, &stats);
+		osd_printf_verbose("Work queue: threads=%d items=%d steals=%d wakeups=%d spinloops=%d\n",
+				stats.threads, (INT32)stats.itemsqueued, (INT32)stats.steals, (INT32)stats.setevents, (INT32)stats.spinloops);
+	}
+
 	// free the list
 	if (queue->thread != NULL)
 		osd_free(queue->thread);
@@ -427,32 +520,16 @@ void osd_work_queue_free(osd_work_queue *queue)
 		osd_event_free(queue->doneevent);
 
 	// free all items in the free list
-	while (queue->free.load() != nullptr)
-	{
-		osd_work_item *item = (osd_work_item *)queue->free;
-		queue->free = item->next;
-		if (item->event != NULL)
-			osd_event_free(item->event);
-		osd_free(item);
-	}
+	free_item_list(queue->free.load());
 
-	// free all items in the active list
-	while (queue->list.load() != nullptr)
+	// free all items still sitting in the deques
+	if (queue->deque != NULL)
 	{
-		osd_work_item *item = (osd_work_item *)queue->list;
-		queue->list = item->next;
-		if (item->event != NULL)
-			osd_event_free(item->event);
-		osd_free(item);
+		for (UINT32 dequenum = 0; dequenum < queue->deques; dequenum++)
+			free_item_list(queue->deque[dequenum].head);
+		osd_free(queue->deque);
 	}
 
-#if KEEP_STATISTICS
-	printf("Items queued   = %9d\n", queue->itemsqueued);
-	printf("SetEvent calls = %9d\n", queue->setevents);
-	printf("Extra items    = %9d\n", queue->extraitems);
-	printf("Spin loops     = %9d\n", queue->spinloops);
-#endif
-
 	delete queue->lock;
 	// free the queue itself
 	osd_free(queue);
@@ -467,21 +544,29 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 {
 	osd_work_item *itemlist = NULL, *lastitem = NULL;
 	osd_work_item **item_tailptr = &itemlist;
+	osd_work_item *freelist;
 	int itemnum;
 
+	// nothing to queue; don't touch the free list or the deques
+	if (numitems <= 0)
+		return NULL;
+
+	// grab as many items as we need from the free list in one go
+	{
+		std::lock_guard<std::mutex> lock(*queue->lock);
+		freelist = queue->free.load();
+		osd_work_item *cut = freelist;
+		for (itemnum = 1; cut != NULL && itemnum < numitems; itemnum++)
+			cut = cut->next;
+		queue->free = (cut != NULL) ? cut->next : NULL;
+		if (cut != NULL)
+			cut->next = NULL;
+	}
+
 	// loop over items, building up a local list of work
 	for (itemnum = 0; itemnum < numitems; itemnum++)
 	{
-		osd_work_item *item;
-
-		// first allocate a new work item; try the free list first
-		{
-			std::lock_guard<std::mutex> lock(*queue->lock);
-			do
-			{
-				item = (osd_work_item *)queue->free;
-			} while (item != NULL && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
-		}
+		osd_work_item *item = freelist;
 
 		// if nothing, allocate something new
 		if (item == NULL)
@@ -496,6 +581,7 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		}
 		else
 		{
+			freelist = item->next;
 			item->done = FALSE; // needs to be set this way to prevent data race/usage of uninitialized memory on Linux
 		}
 
@@ -513,37 +599,47 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		parambase = (UINT8 *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
-	{
-		std::lock_guard<std::mutex> lock(*queue->lock);
-		*queue->tailptr = itemlist;
-		queue->tailptr = item_tailptr;
-	}
-
-	// increment the number of items in the queue
+	// count the items before anyone can pick them up
 	queue->items += numitems;
-	add_to_stat(queue->itemsqueued, numitems);
+	queue->pending += numitems;
+	queue->itemsqueued.fetch_add(numitems, std::memory_order_relaxed);
 
-	// look for free threads to do the work
-	if (queue->livethreads < queue->threads)
+	// start with an idle thread's deque if there is one, so a lone item doesn't
+	// sit behind a busy thread waiting to be stolen
+	UINT32 firstdeque = queue->nextdeque++ % queue->deques;
+	for (UINT32 dequenum = 0; dequenum < queue->threads; dequenum++)
 	{
-		int threadnum;
-
-		// iterate over all the threads
-		for (threadnum = 0; threadnum < queue->threads; threadnum++)
+		UINT32 candidate = (firstdeque + dequenum) % queue->deques;
+		if (!queue->thread[candidate].active)
 		{
-			work_thread_info *thread = &queue->thread[threadnum];
+			firstdeque = candidate;
+			break;
+		}
+	}
 
-			// if this thread is not active, wake him up
-			if (!thread->active)
-			{
-				osd_event_set(thread->wakeevent);
-				add_to_stat(queue->setevents, 1);
+	// hand out contiguous batches so neighbouring items tend to stay on one thread
+	INT32 batches = MIN(numitems, (INT32)queue->deques);
+	INT32 batchsize = (numitems + batches - 1) / batches;
+	osd_work_item *batch = itemlist;
+	for (UINT32 dequenum = firstdeque; batch != NULL; dequenum = (dequenum + 1) % queue->deques)
+	{
+		osd_work_item *last = batch;
+		INT32 count = 1;
+		while (count < batchsize && last->next != NULL)
+		{
+			last = last->next;
+			count++;
+		}
+		osd_work_item *next = last->next;
+		last->next = NULL;
+		deque_push(queue->deque[dequenum], batch, last, count);
+		batch = next;
 
-				// for non-shared, the first one we find is good enough
-				if (--numitems == 0)
-					break;
-			}
+		// wake the owner if it is asleep
+		if (dequenum < queue->threads && !queue->thread[dequenum].active)
+		{
+			osd_event_set(queue->thread[dequenum].wakeevent);
+			queue->setevents.fetch_add(1, std::memory_order_relaxed);
 		}
 	}
 
@@ -696,18 +792,18 @@ static void *worker_thread_entry(void *param)
 			worker_thread_process(queue, thread);
 
 			// if we're a high frequency queue, spin for a while before giving up
-			if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->list.load() == nullptr)
+			if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->pending == 0)
 			{
 				// spin for a while looking for more work
 				begin_timing(thread->spintime);
-				spin_while<std::atomic<osd_work_item *>, osd_work_item *>(&queue->list, (osd_work_item *)nullptr, SPIN_LOOP_TIME);
+				spin_while<std::atomic<INT32>, INT32>(&queue->pending, 0, SPIN_LOOP_TIME);
 				end_timing(thread->spintime);
 			}
 
 			// if nothing more, release the processor
 			if (!queue_has_list_items(queue))
 				break;
-			add_to_stat(queue->spinloops, 1);
+			queue->spinloops.fetch_add(1, std::memory_order_relaxed);
 		}
 
 		// decrement the live thread count
@@ -730,6 +826,7 @@ static void *worker_thread_entry(void *param)
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
 {
 	int threadid = thread - queue->thread;
+	work_deque *own = (threadid < queue->deques) ? &queue->deque[threadid] : NULL;
 
 	begin_timing(thread->runtime);
 
@@ -737,65 +834,42 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	while (true)
 	{
 		osd_work_item *item = NULL;
+		osd_work_item *last;
+		INT32 taken;
 
-		bool end_loop = false;
+		// take from our own deque first, then go stealing
+		if (own != NULL)
+			item = deque_take(*own, false, last, taken);
+		if (item == NULL)
+			item = steal_items(queue, thread, own);
+		if (item == NULL)
+			break;
+		--queue->pending;
 
-		// use a critical section to synchronize the removal of items
-		{
-			std::lock_guard<std::mutex> lock(*queue->lock);
+		// call the callback and stash the result
+		begin_timing(thread->actruntime);
+		item->result = (*item->callback)(item->param, threadid);
+		end_timing(thread->actruntime);
 
-			if (queue->list.load() == nullptr)
-			{
-				end_loop = true;
-			}
-			else
-			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != NULL)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
-			}
-		}
+		// decrement the item count after we are done
+		--queue->items;
+		item->done = TRUE;
+		thread->itemsdone.fetch_add(1, std::memory_order_relaxed);
 
-		if (end_loop)
-			break;
+		// if it's an auto-release item, release it
+		if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+			osd_work_item_release(item);
 
-		// process non-NULL items
-		if (item != NULL)
+		// set the result and signal the event
+		else
 		{
-			// call the callback and stash the result
-			begin_timing(thread->actruntime);
-			item->result = (*item->callback)(item->param, threadid);
-			end_timing(thread->actruntime);
-
-			// decrement the item count after we are done
-			--queue->items;
-			item->done = TRUE;
-			add_to_stat(thread->itemsdone, 1);
-
-			// if it's an auto-release item, release it
-			if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
-				osd_work_item_release(item);
-
-			// set the result and signal the event
-			else
-			{
-				std::lock_guard<std::mutex> lock(*queue->lock);
+			std::lock_guard<std::mutex> lock(*queue->lock);
 
-				if (item->event != NULL)
-				{
-					osd_event_set(item->event);
-					add_to_stat(item->queue->setevents, 1);
-				}
+			if (item->event != NULL)
+			{
+				osd_event_set(item->event);
+				item->queue->setevents.fetch_add(1, std::memory_order_relaxed);
 			}
-
-			// if we removed an item and there's still work to do, bump the stats
-			if (queue_has_list_items(queue))
-				add_to_stat(queue->extraitems, 1);
 		}
 	}
 
@@ -803,15 +877,90 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	if (queue->waiting)
 	{
 		osd_event_set(queue->doneevent);
-		add_to_stat(queue->setevents, 1);
+		queue->setevents.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	end_timing(thread->runtime);
 }
 
-bool queue_has_list_items(osd_work_queue *queue)
+
+//============================================================
+//  steal_items - take work from another thread's deque;
+//  threads with a deque of their own take half of the
+//  victim's items and keep the rest for later
+//============================================================
+
+static osd_work_item *steal_items(osd_work_queue *queue, work_thread_info *thread, work_deque *own)
 {
-	std::lock_guard<std::mutex> lock(*queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	int threadid = thread - queue->thread;
+
+	for (UINT32 offset = 1; offset <= queue->deques; offset++)
+	{
+		work_deque &victim = queue->deque[(threadid + offset) % queue->deques];
+		if (&victim == own)
+			continue;
+
+		osd_work_item *last;
+		INT32 taken;
+		osd_work_item *first = deque_take(victim, own != NULL, last, taken);
+		if (first != NULL)
+		{
+			thread->steals.fetch_add(taken, std::memory_order_relaxed);
+			if (first->next != NULL)
+				deque_push(*own, first->next, last, taken - 1);
+			first->next = NULL;
+			return first;
+		}
+	}
+	return NULL;
+}
+
+
+//============================================================
+//  queue_has_list_items
+//============================================================
+
+static bool queue_has_list_items(osd_work_queue *queue)
+{
+	return (queue->pending != 0);
+}
+
+
+//============================================================
+//  free_item_list
+//============================================================
+
+static void free_item_list(osd_work_item *item)
+{
+	while (item != NULL)
+	{
+		osd_work_item *next = item->next;
+		if (item->event != NULL)
+			osd_event_free(item->event);
+		osd_free(item);
+		item = next;
+	}
+}
+
+
+//============================================================
+//  osd_work_queue_get_stats
+//============================================================
+
+void osd_work_queue_get_stats(osd_work_queue *queue, osd_work_queue_stats *stats)
+{
+	int allocthreadnum = (queue->flags & WORK_QUEUE_FLAG_MULTI) ? (queue->threads + 1) : MAX(queue->threads, 1);
+
+	memset(stats, 0, sizeof(*stats));
+	stats->threads = queue->threads;
+	stats->itemsqueued = queue->itemsqueued.load(std::memory_order_relaxed);
+	stats->setevents = queue->setevents.load(std::memory_order_relaxed);
+	stats->spinloops = queue->spinloops.load(std::memory_order_relaxed);
+	for (int threadnum = 0; threadnum < allocthreadnum && threadnum <= WORK_MAX_THREADS; threadnum++)
+	{
+		work_thread_info &thread = queue->thread[threadnum];
+		stats->threaditems[threadnum] = thread.itemsdone.load(std::memory_order_relaxed);
+		stats->itemsdone += stats->threaditems[threadnum];
+		stats->steals += thread.steals.load(std::memory_order_relaxed);
+	}
 }
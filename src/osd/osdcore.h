@@ -224,6 +224,76 @@ public:
 	        the file, or FILERR_NONE if no error occurred
 	-----------------------------------------------------------------------------*/
 	static error remove(std::string const &filename);
+
+
+	/*-----------------------------------------------------------------------------
+	    osd_file::rename: renames a file, replacing any existing file of the
+	    new name
+
+	    Parameters:
+
+	        oldname - path to the file to rename
+
+	        newname - path to give the file; must be on the same volume
+
+	    Return value:
+
+	        a file_error describing any error that occurred while renaming
+	        the file, or FILERR_NONE if no error occurred
+
+	    Notes:
+
+	        Where the host supports it the replacement is atomic, so other
+	        processes opening newname see either the old or the new file.
+	-----------------------------------------------------------------------------*/
+	static error rename(std::string const &oldname, std::string const &newname);
+
+
+	/*-----------------------------------------------------------------------------
+	    osd_file::map: map part of a file into memory
+
+	    Parameters:
+
+	        path - path to the file to map
+
+	        offset - offset within the file of the first byte to map
+
+	        length - number of bytes to map; the range must lie entirely
+	            within the file
+
+	        base - reference to a pointer to receive the address of the first
+	            mapped byte; this is only valid if the function returns
+	            FILERR_NONE
+
+	    Return value:
+
+	        a file_error describing any error that occurred while mapping
+	        the file, or FILERR_NONE if no error occurred
+
+	    Notes:
+
+	        The mapping is private and copy-on-write: it may be modified, but
+	        changes are never written back to the file. Pages are read from
+	        the file on demand and may be shared between processes until they
+	        are modified. The mapping stays valid until it is released with
+	        osd_file::unmap. Implementations that cannot map files return
+	        FILERR_FAILURE and callers are expected to fall back to read.
+	        The returned address has the same alignment as offset within a
+	        page, so callers that need wider alignment must check it.
+	-----------------------------------------------------------------------------*/
+	static error map(std::string const &path, std::uint64_t offset, std::uint32_t length, void *&base);
+
+
+	/*-----------------------------------------------------------------------------
+	    osd_file::unmap: release a mapping created by osd_file::map
+
+	    Parameters:
+
+	        base - address returned by osd_file::map
+
+	        length - number of bytes passed to osd_file::map
+	-----------------------------------------------------------------------------*/
+	static void unmap(void *base, std::uint32_t length);
 };
 
 
@@ -316,6 +386,7 @@ struct osd_directory_entry
 	const char *        name;           /* name of the entry */
 	osd_dir_entry_type  type;           /* type of the entry */
 	UINT64              size;           /* size of the entry */
+	INT64               last_modified;  /* modification time in seconds since the epoch, or 0 if unknown */
 };
 
 
@@ -546,6 +617,39 @@ int osd_work_queue_items(osd_work_queue *queue);
 int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout);
 
 
+/*-----------------------------------------------------------------------------
+    osd_work_queue_get_stats: return activity counters for a work queue
+
+    Parameters:
+
+        queue - pointer to an osd_work_queue that was previously created via
+            osd_work_queue_alloc
+
+        stats - pointer to an osd_work_queue_stats structure to fill in
+
+    Return value:
+
+        None.
+
+    Notes:
+
+        The counters are maintained with relaxed atomics, so a snapshot
+        taken while items are being processed may be slightly inconsistent.
+-----------------------------------------------------------------------------*/
+struct osd_work_queue_stats
+{
+	UINT32      threads;                                /* number of worker threads */
+	UINT64      itemsqueued;                            /* total items queued */
+	UINT64      itemsdone;                              /* total items completed */
+	UINT64      steals;                                 /* items taken from another thread's deque */
+	UINT64      setevents;                              /* number of times a thread was woken */
+	UINT64      spinloops;                              /* how many times spinning found more work */
+	UINT64      threaditems[WORK_MAX_THREADS + 1];      /* items completed per thread, calling thread last */
+};
+
+void osd_work_queue_get_stats(osd_work_queue *queue, osd_work_queue_stats *stats);
+
+
 /*-----------------------------------------------------------------------------
     osd_work_queue_free: free a work queue, waiting for all items to complete
 
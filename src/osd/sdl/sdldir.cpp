@@ -133,6 +133,14 @@ static UINT64 osd_get_file_size(const char *file)
 	return st.st_size;
 }
 
+static INT64 osd_get_file_mtime(const char *file)
+{
+	sdl_stat st;
+	if(sdl_stat_fn(file, &st))
+		return 0;
+	return st.st_mtime;
+}
+
 //============================================================
 //  osd_opendir
 //============================================================
@@ -220,6 +228,7 @@ const osd_directory_entry *osd_readdir(osd_directory *dir)
 	dir->ent.type = get_attributes_stat(temp);
 	#endif
 	dir->ent.size = osd_get_file_size(temp);
+	dir->ent.last_modified = osd_get_file_mtime(temp);
 	osd_free(temp);
 	return &dir->ent;
 }
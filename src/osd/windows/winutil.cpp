@@ -35,6 +35,20 @@ osd_dir_entry_type win_attributes_to_entry_type(DWORD attributes)
 
 
 
+//============================================================
+//  win_filetime_to_seconds
+//============================================================
+
+INT64 win_filetime_to_seconds(const FILETIME &filetime)
+{
+	// FILETIME counts 100ns intervals since 1601; convert to seconds since 1970
+	INT64 const ticks = filetime.dwLowDateTime | (INT64(filetime.dwHighDateTime) << 32);
+	if (ticks == 0)
+		return 0;
+	return (ticks - 116444736000000000LL) / 10000000;
+}
+
+
 //============================================================
 //  win_is_gui_application
 //============================================================
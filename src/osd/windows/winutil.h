@@ -15,6 +15,7 @@
 
 // Shared code
 osd_dir_entry_type win_attributes_to_entry_type(DWORD attributes);
+INT64 win_filetime_to_seconds(const FILETIME &filetime);
 BOOL win_is_gui_application(void);
 HMODULE WINAPI GetModuleHandleUni();
 
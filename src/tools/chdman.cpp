@@ -539,7 +539,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression or decompression" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -560,7 +560,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -636,7 +637,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -649,7 +651,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -660,6 +663,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -1123,6 +1127,20 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  enable_parallel_read - widen the read-ahead
+//  window of an input CHD that is about to be
+//  read from start to finish, so that hunks are
+//  decompressed on all available processors while
+//  we consume them in order
+//-------------------------------------------------
+
+static void enable_parallel_read(chd_file &input_chd)
+{
+	input_chd.set_readahead(chd_file::MAX_READAHEAD_HUNKS);
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1493,6 +1511,7 @@ static void do_verify(parameters_t &params)
 	chd_file input_parent_chd;
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
+	parse_numprocessors(params);
 
 	// only makes sense for compressed CHDs with valid SHA1's
 	if (!input_chd.compressed())
@@ -1504,7 +1523,8 @@ static void do_verify(parameters_t &params)
 	// create an array to read into
 	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
-	// read all the data and build up an SHA-1
+	// read all the data and build up an SHA-1; hunks are decompressed and CRC-checked in parallel
+	enable_parallel_read(input_chd);
 	sha1_creator rawsha1;
 	for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
 	{
@@ -2219,6 +2239,7 @@ static void do_extract_raw(parameters_t &params)
 	UINT64 input_start;
 	UINT64 input_end;
 	parse_input_start_end(params, input_chd.logical_bytes(), input_chd.hunk_bytes(), input_chd.hunk_bytes(), input_start, input_end);
+	parse_numprocessors(params);
 
 	// verify output file doesn't exist
 	auto output_file_str = params.find(OPTION_OUTPUT);
@@ -2246,6 +2267,7 @@ static void do_extract_raw(parameters_t &params)
 
 		// copy all data
 		dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		enable_parallel_read(input_chd);
 		for (UINT64 offset = input_start; offset < input_end; )
 		{
 			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
@@ -2293,6 +2315,8 @@ static void do_extract_cd(parameters_t &params)
 	chd_file input_parent_chd;
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
+	parse_numprocessors(params);
+	enable_parallel_read(input_chd);
 
 	// further process input file
 	cdrom_file *cdrom = cdrom_open(&input_chd);